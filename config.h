@@ -11,6 +11,10 @@
 #  define ENCHIVE_FORMAT_VERSION 3
 #endif
 
+#ifndef ENCHIVE_ARCHIVE_FORMAT
+#  define ENCHIVE_ARCHIVE_FORMAT 3
+#endif
+
 #ifndef ENCHIVE_FILE_EXTENSION
 #  define ENCHIVE_FILE_EXTENSION .enchive
 #endif
@@ -31,10 +35,48 @@
 #  endif
 #endif
 
+#ifndef ENCHIVE_OPTION_THREADS
+#  if defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#    define ENCHIVE_OPTION_THREADS 1
+#  else
+#    define ENCHIVE_OPTION_THREADS 0
+#  endif
+#endif
+
+#ifndef ENCHIVE_OPTION_RAWIO
+#  if defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#    define ENCHIVE_OPTION_RAWIO 1
+#  else
+#    define ENCHIVE_OPTION_RAWIO 0
+#  endif
+#endif
+
+/* Only on when the kernel headers can be seen to have io_uring. */
+#ifndef ENCHIVE_OPTION_URING
+#  if defined(__linux__) && !defined(__COSMOPOLITAN__) && ENCHIVE_OPTION_RAWIO
+#    ifdef __has_include
+#      if __has_include(<linux/io_uring.h>)
+#        define ENCHIVE_OPTION_URING 1
+#      endif
+#    endif
+#  endif
+#  ifndef ENCHIVE_OPTION_URING
+#    define ENCHIVE_OPTION_URING 0
+#  endif
+#endif
+
 #ifndef ENCHIVE_AGENT_TIMEOUT
 #  define ENCHIVE_AGENT_TIMEOUT 900 /* 15 minutes */
 #endif
 
+#ifndef ENCHIVE_POOL_TIMEOUT
+#  define ENCHIVE_POOL_TIMEOUT 900 /* 15 minutes */
+#endif
+
+#ifndef ENCHIVE_POOL_SIZE
+#  define ENCHIVE_POOL_SIZE 32
+#endif
+
 #ifndef ENCHIVE_AGENT_DEFAULT_ENABLED
 #  define ENCHIVE_AGENT_DEFAULT_ENABLED 0
 #endif
@@ -57,6 +99,11 @@
 #  define _POSIX_C_SOURCE 1
 #endif
 
+/* Linux-specific interfaces (huge pages, etc.) */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
 #define OPTPARSE_IMPLEMENTATION
 
 #define STR(a) XSTR(a)
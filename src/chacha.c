@@ -4,6 +4,7 @@ D. J. Bernstein
 Public domain.
 */
 
+#include <string.h>
 #include "chacha.h"
 
 #define U8V(v)  ((uint8_t)(v)  & UINT8_C(0xFF))
@@ -34,14 +35,16 @@ Public domain.
   x[a] = PLUS(x[a],x[b]); x[d] = ROTATE(XOR(x[d],x[a]), 8); \
   x[c] = PLUS(x[c],x[d]); x[b] = ROTATE(XOR(x[b],x[c]), 7);
 
+/* The round count is a constant at every call, so each kernel below
+ * is compiled separately for 8, 12 and 20 rounds. */
 static void
-salsa20_wordtobyte(uint8_t output[64], const uint32_t input[16])
+salsa20_wordtobyte(uint8_t output[64], const uint32_t input[16], int rounds)
 {
   uint32_t x[16];
   int i;
 
   for (i = 0;i < 16;++i) x[i] = input[i];
-  for (i = 8;i > 0;i -= 2) {
+  for (i = rounds;i > 0;i -= 2) {
     QUARTERROUND( 0, 4, 8,12)
     QUARTERROUND( 1, 5, 9,13)
     QUARTERROUND( 2, 6,10,14)
@@ -81,6 +84,13 @@ chacha_keysetup(chacha_ctx *x, const uint8_t *k, uint32_t kbits)
   x->input[1] = U8TO32_LITTLE(constants + 4);
   x->input[2] = U8TO32_LITTLE(constants + 8);
   x->input[3] = U8TO32_LITTLE(constants + 12);
+  x->rounds = CHACHA_ROUNDS;
+}
+
+void
+chacha_rounds(chacha_ctx *x, int rounds)
+{
+  x->rounds = rounds;
 }
 
 void
@@ -93,17 +103,25 @@ chacha_ivsetup(chacha_ctx *x, const uint8_t *iv)
 }
 
 void
-chacha_encrypt(chacha_ctx *x, const uint8_t *m, uint8_t *c, uint32_t bytes)
+chacha_seek(chacha_ctx *x, uint64_t block)
+{
+  x->input[12] = U32V(block);
+  x->input[13] = U32V(block >> 32);
+}
+
+static void
+chacha_ref(uint32_t input[16], const uint8_t *m, uint8_t *c, uint32_t bytes,
+           int rounds)
 {
   uint8_t output[64];
   uint32_t i;
 
   if (!bytes) return;
   for (;;) {
-    salsa20_wordtobyte(output,x->input);
-    x->input[12] = PLUSONE(x->input[12]);
-    if (!x->input[12]) {
-      x->input[13] = PLUSONE(x->input[13]);
+    salsa20_wordtobyte(output,input,rounds);
+    input[12] = PLUSONE(input[12]);
+    if (!input[12]) {
+      input[13] = PLUSONE(input[13]);
       /* stopping at 2^70 bytes per nonce is user's responsibility */
     }
     if (bytes <= 64) {
@@ -116,3 +134,221 @@ chacha_encrypt(chacha_ctx *x, const uint8_t *m, uint8_t *c, uint32_t bytes)
     m += 64;
   }
 }
+
+/* Multi-block kernels
+ *
+ * The vector kernels below run the reference quarter round over GCC
+ * vector extension types, computing one block per vector lane, so no
+ * intrinsics headers are needed (important for the amalgamation
+ * builds). Each kernel consumes exactly as much keystream as the
+ * reference code: one 64-byte block per 64 bytes of input, with a
+ * partial final block discarding the rest of its keystream.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define CHACHA_X86 1
+
+typedef uint32_t chacha_v4 __attribute__((vector_size(16)));
+typedef uint32_t chacha_v8 __attribute__((vector_size(32)));
+typedef uint32_t chacha_v16 __attribute__((vector_size(64)));
+
+#define VROTATE(v,c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define VQUARTERROUND(a,b,c,d) \
+  x[a] += x[b]; x[d] = VROTATE(x[d] ^ x[a],16); \
+  x[c] += x[d]; x[b] = VROTATE(x[b] ^ x[c],12); \
+  x[a] += x[b]; x[d] = VROTATE(x[d] ^ x[a], 8); \
+  x[c] += x[d]; x[b] = VROTATE(x[b] ^ x[c], 7);
+
+/* Body of a ROUNDS-round kernel processing LANES blocks at a time in
+ * vectors of type VEC. The block counter in input[12..13] is advanced
+ * exactly as the reference implementation would advance it. */
+#define CHACHA_VECTOR_BODY(VEC, LANES, ROUNDS)                          \
+  VEC x[16], s[16], zero = {0};                                         \
+  uint8_t block[LANES * 64];                                            \
+  uint32_t i, j, n;                                                     \
+  while (bytes) {                                                       \
+    for (i = 0; i < 16; i++)                                            \
+      s[i] = zero + input[i];                                           \
+    for (j = 0; j < LANES; j++) {                                       \
+      s[12][j] = PLUS(input[12], j);                                    \
+      s[13][j] = input[13] + (s[12][j] < input[12]);                    \
+    }                                                                   \
+    for (i = 0; i < 16; i++) x[i] = s[i];                               \
+    for (i = ROUNDS; i > 0; i -= 2) {                                   \
+      VQUARTERROUND( 0, 4, 8,12)                                        \
+      VQUARTERROUND( 1, 5, 9,13)                                        \
+      VQUARTERROUND( 2, 6,10,14)                                        \
+      VQUARTERROUND( 3, 7,11,15)                                        \
+      VQUARTERROUND( 0, 5,10,15)                                        \
+      VQUARTERROUND( 1, 6,11,12)                                        \
+      VQUARTERROUND( 2, 7, 8,13)                                        \
+      VQUARTERROUND( 3, 4, 9,14)                                        \
+    }                                                                   \
+    for (i = 0; i < 16; i++) x[i] += s[i];                              \
+    /* Transpose lanes into consecutive blocks (little endian) */       \
+    for (j = 0; j < LANES; j++)                                         \
+      for (i = 0; i < 16; i++) {                                        \
+        uint32_t w = x[i][j];                                           \
+        memcpy(block + 64 * j + 4 * i, &w, 4);                          \
+      }                                                                 \
+    n = bytes < LANES * 64 ? bytes : LANES * 64;                        \
+    chacha_xor(c, m, block, n);                                         \
+    j = (n + 63) / 64;                                                  \
+    input[12] = PLUS(input[12], j);                                     \
+    if (input[12] < j)                                                  \
+      input[13] = PLUSONE(input[13]);                                   \
+    bytes -= n;                                                         \
+    c += n;                                                             \
+    m += n;                                                             \
+  }
+
+/* c = m ^ k over n bytes, 16 bytes at a time where possible. */
+static void
+chacha_xor(uint8_t *c, const uint8_t *m, const uint8_t *k, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 16 <= n; i += 16) {
+    chacha_v4 a, b;
+    memcpy(&a, m + i, 16);
+    memcpy(&b, k + i, 16);
+    a ^= b;
+    memcpy(c + i, &a, 16);
+  }
+  for (; i < n; i++)
+    c[i] = m[i] ^ k[i];
+}
+
+/* Kernel entry points for ROUNDS rounds: inputs too short for a
+ * kernel's vector width fall through to the next narrower kernel. */
+#define CHACHA_X86_KERNELS(ROUNDS)                                      \
+__attribute__((target("sse2")))                                         \
+static void                                                             \
+chacha_blocks4_##ROUNDS(uint32_t input[16], const uint8_t *m,           \
+                        uint8_t *c, uint32_t bytes)                     \
+{                                                                       \
+  CHACHA_VECTOR_BODY(chacha_v4, 4, ROUNDS)                              \
+}                                                                       \
+                                                                        \
+__attribute__((target("avx2")))                                         \
+static void                                                             \
+chacha_blocks8_##ROUNDS(uint32_t input[16], const uint8_t *m,           \
+                        uint8_t *c, uint32_t bytes)                     \
+{                                                                       \
+  CHACHA_VECTOR_BODY(chacha_v8, 8, ROUNDS)                              \
+}                                                                       \
+                                                                        \
+__attribute__((target("avx512f")))                                      \
+static void                                                             \
+chacha_blocks16_##ROUNDS(uint32_t input[16], const uint8_t *m,          \
+                         uint8_t *c, uint32_t bytes)                    \
+{                                                                       \
+  CHACHA_VECTOR_BODY(chacha_v16, 16, ROUNDS)                            \
+}                                                                       \
+                                                                        \
+static void                                                             \
+chacha_sse2_##ROUNDS(uint32_t input[16], const uint8_t *m,              \
+                     uint8_t *c, uint32_t bytes)                        \
+{                                                                       \
+  if (bytes >= 128)                                                     \
+    chacha_blocks4_##ROUNDS(input, m, c, bytes);                        \
+  else                                                                  \
+    chacha_ref(input, m, c, bytes, ROUNDS);                             \
+}                                                                       \
+                                                                        \
+static void                                                             \
+chacha_avx2_##ROUNDS(uint32_t input[16], const uint8_t *m,              \
+                     uint8_t *c, uint32_t bytes)                        \
+{                                                                       \
+  if (bytes >= 512)                                                     \
+    chacha_blocks8_##ROUNDS(input, m, c, bytes);                        \
+  else                                                                  \
+    chacha_sse2_##ROUNDS(input, m, c, bytes);                           \
+}                                                                       \
+                                                                        \
+static void                                                             \
+chacha_avx512_##ROUNDS(uint32_t input[16], const uint8_t *m,            \
+                       uint8_t *c, uint32_t bytes)                      \
+{                                                                       \
+  /* Whole 16-block groups here, the tail goes to a narrower kernel. */ \
+  uint32_t n = bytes / 1024 * 1024;                                     \
+  if (n)                                                                \
+    chacha_blocks16_##ROUNDS(input, m, c, n);                           \
+  chacha_avx2_##ROUNDS(input, m + n, c + n, bytes - n);                 \
+}
+
+CHACHA_X86_KERNELS(8)
+CHACHA_X86_KERNELS(12)
+CHACHA_X86_KERNELS(20)
+#endif /* CHACHA_X86 */
+
+#define CHACHA_REF_KERNEL(ROUNDS)                                       \
+static void                                                             \
+chacha_ref_##ROUNDS(uint32_t input[16], const uint8_t *m,               \
+                    uint8_t *c, uint32_t bytes)                         \
+{                                                                       \
+  chacha_ref(input, m, c, bytes, ROUNDS);                               \
+}
+
+CHACHA_REF_KERNEL(8)
+CHACHA_REF_KERNEL(12)
+CHACHA_REF_KERNEL(20)
+
+typedef void (*chacha_fn)(uint32_t *, const uint8_t *, uint8_t *, uint32_t);
+
+/* Best first, matching chacha_kernels, with columns for 8, 12 and 20
+ * rounds. */
+#define CHACHA_IMPLS(NAME) {NAME##_8, NAME##_12, NAME##_20}
+static const chacha_fn chacha_impls[][3] = {
+#ifdef CHACHA_X86
+  CHACHA_IMPLS(chacha_avx512),
+  CHACHA_IMPLS(chacha_avx2),
+  CHACHA_IMPLS(chacha_sse2),
+#endif
+  CHACHA_IMPLS(chacha_ref)
+};
+
+const struct cpu_kernel chacha_kernels[] = {
+#ifdef CHACHA_X86
+  {"avx512", CPU_AVX512F},
+  {"avx2", CPU_AVX2},
+  {"sse2", CPU_SSE2},
+#endif
+  {"portable", 0},
+  {0, 0}
+};
+
+static int chacha_current = -1;
+static const chacha_fn *chacha_impl;
+
+void
+chacha_kernel_use(int kernel)
+{
+  chacha_current = kernel;
+  chacha_impl = chacha_impls[kernel];
+}
+
+int
+chacha_kernel_current(void)
+{
+  if (chacha_current < 0)
+    chacha_kernel_use(cpu_best(chacha_kernels));
+  return chacha_current;
+}
+
+void
+chacha_encrypt(chacha_ctx *x, const uint8_t *m, uint8_t *c, uint32_t bytes)
+{
+  if (!chacha_impl)
+    chacha_kernel_current();
+  switch (x->rounds) {
+    case 12:
+      chacha_impl[1](x->input, m, c, bytes);
+      break;
+    case 20:
+      chacha_impl[2](x->input, m, c, bytes);
+      break;
+    default:
+      chacha_impl[0](x->input, m, c, bytes);
+  }
+}
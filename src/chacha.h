@@ -2,15 +2,28 @@
 #define CHACHA_H
 
 #include "../config.h"
+#include "cpu.h"
 
 #define CHACHA_BLOCKLENGTH 64
 
+/* Round count after chacha_keysetup(). The kernels are specialized for
+ * 8, 12 and 20 rounds, and chacha_rounds() picks one of these. */
+#define CHACHA_ROUNDS 8
+
 typedef struct {
     uint32_t input[16];
+    int rounds;
 } chacha_ctx;
 
 void chacha_keysetup(chacha_ctx *, const uint8_t *k, uint32_t kbits);
 void chacha_ivsetup(chacha_ctx *, const uint8_t *iv);
+void chacha_rounds(chacha_ctx *, int rounds);
+void chacha_seek(chacha_ctx *, uint64_t block);
 void chacha_encrypt(chacha_ctx *, const uint8_t *m, uint8_t *c, uint32_t bytes);
 
+/* Runtime kernel selection, see cpu.h. */
+extern const struct cpu_kernel chacha_kernels[];
+void chacha_kernel_use(int kernel);
+int chacha_kernel_current(void);
+
 #endif /* CHACHA_H */
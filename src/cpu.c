@@ -0,0 +1,194 @@
+#include <string.h>
+#include "cpu.h"
+#include "chacha.h"
+#include "sha256.h"
+#include "curve25519-donna.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+static void
+cpuid(uint32_t leaf, uint32_t subleaf, uint32_t r[4])
+{
+    __asm__ __volatile__ ("cpuid"
+                          : "=a"(r[0]), "=b"(r[1]), "=c"(r[2]), "=d"(r[3])
+                          : "a"(leaf), "c"(subleaf));
+}
+
+static unsigned long
+cpu_probe(void)
+{
+    unsigned long features = 0;
+    uint32_t r[4], max, xcr0 = 0;
+
+    cpuid(0, 0, r);
+    max = r[0];
+    if (max < 1)
+        return 0;
+
+    cpuid(1, 0, r);
+    if (r[3] & (1UL << 26))
+        features |= CPU_SSE2;
+    if (r[2] & (1UL << 19))
+        features |= CPU_SSE41;
+    if (r[2] & (1UL << 27)) {
+        /* OSXSAVE: ask which register state the OS preserves. */
+        uint32_t edx;
+        __asm__ __volatile__ ("xgetbv" : "=a"(xcr0), "=d"(edx) : "c"(0));
+    }
+
+    if (max >= 7) {
+        cpuid(7, 0, r);
+        if ((r[1] & (1UL << 5)) && (xcr0 & 0x06) == 0x06)
+            features |= CPU_AVX2;
+        if (r[1] & (1UL << 8))
+            features |= CPU_BMI2;
+        if ((r[1] & (1UL << 16)) && (xcr0 & 0xe6) == 0xe6)
+            features |= CPU_AVX512F;
+        if (r[1] & (1UL << 29))
+            features |= CPU_SHA;
+    }
+    return features;
+}
+
+double
+cpu_cycles(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+    return hi * 4294967296.0 + lo;
+}
+
+#else
+static unsigned long
+cpu_probe(void)
+{
+    return 0;
+}
+
+double
+cpu_cycles(void)
+{
+    return 0;
+}
+#endif
+
+unsigned long
+cpu_features(void)
+{
+    static int probed;
+    static unsigned long features;
+    if (!probed) {
+        features = cpu_probe();
+        probed = 1;
+    }
+    return features;
+}
+
+int
+cpu_best(const struct cpu_kernel *kernels)
+{
+    unsigned long have = cpu_features();
+    int i;
+    for (i = 0; kernels[i + 1].name; i++)
+        if ((kernels[i].features & have) == kernels[i].features)
+            break;
+    return i; /* the last kernel is always portable */
+}
+
+static const struct {
+    const char *name;
+    const struct cpu_kernel *kernels;
+    void (*use)(int);
+    int (*current)(void);
+} primitives[] = {
+    {"chacha",     chacha_kernels,     chacha_kernel_use,
+                   chacha_kernel_current},
+    {"sha256",     sha256_kernels,     sha256_kernel_use,
+                   sha256_kernel_current},
+    {"curve25519", curve25519_kernels, curve25519_kernel_use,
+                   curve25519_kernel_current},
+};
+
+#define NPRIMITIVES (sizeof(primitives) / sizeof(*primitives))
+
+/**
+ * Return the index of the kernel named by the LEN bytes at NAME.
+ */
+static int
+kernel_find(const struct cpu_kernel *kernels, const char *name, size_t len)
+{
+    int i;
+    for (i = 0; kernels[i].name; i++)
+        if (strlen(kernels[i].name) == len &&
+            !memcmp(kernels[i].name, name, len))
+            return i;
+    return -1;
+}
+
+const char *
+cpu_select(const char *spec)
+{
+    unsigned long have = cpu_features();
+    int choice[NPRIMITIVES];
+    size_t i;
+
+    for (i = 0; i < NPRIMITIVES; i++)
+        choice[i] = cpu_best(primitives[i].kernels);
+
+    while (spec && *spec) {
+        const char *end = strchr(spec, ',');
+        const char *eq = strchr(spec, '=');
+        const char *name = spec;
+        size_t len;
+        int found = 0;
+
+        if (!end)
+            end = spec + strlen(spec);
+        if (eq > end)
+            eq = 0;
+        if (eq)
+            name = eq + 1;
+        len = end - name;
+
+        for (i = 0; i < NPRIMITIVES; i++) {
+            const struct cpu_kernel *k = primitives[i].kernels;
+            int n;
+            if (eq && (strlen(primitives[i].name) != (size_t)(eq - spec) ||
+                       memcmp(primitives[i].name, spec, eq - spec)))
+                continue;
+            n = kernel_find(k, name, len);
+            if (n < 0)
+                continue;
+            if ((k[n].features & have) != k[n].features)
+                return "kernel not supported by this CPU";
+            choice[i] = n;
+            found = 1;
+        }
+        if (!found)
+            return "unknown kernel";
+
+        spec = *end ? end + 1 : end;
+    }
+
+    for (i = 0; i < NPRIMITIVES; i++)
+        primitives[i].use(choice[i]);
+    return 0;
+}
+
+void
+cpu_print(FILE *f)
+{
+    unsigned long have = cpu_features();
+    size_t i;
+    for (i = 0; i < NPRIMITIVES; i++) {
+        const struct cpu_kernel *k = primitives[i].kernels;
+        int current = primitives[i].current();
+        int n;
+        fprintf(f, "%-11s", primitives[i].name);
+        for (n = 0; k[n].name; n++) {
+            int ok = (k[n].features & have) == k[n].features;
+            fprintf(f, " %s%s%s%s", ok ? "" : "(", k[n].name,
+                    ok ? "" : ")", n == current ? "*" : "");
+        }
+        fputc('\n', f);
+    }
+}
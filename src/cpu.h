@@ -0,0 +1,57 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdio.h>
+#include "../config.h"
+
+/* CPU features that kernels may require. */
+#define CPU_SSE2     (1UL << 0)
+#define CPU_SSE41    (1UL << 1)
+#define CPU_AVX2     (1UL << 2)
+#define CPU_BMI2     (1UL << 3)
+#define CPU_AVX512F  (1UL << 4)
+#define CPU_SHA      (1UL << 5)
+
+/**
+ * Return the features of the running CPU, probed once and cached.
+ * Only features the operating system has enabled are reported.
+ */
+unsigned long cpu_features(void);
+
+/**
+ * Return a free-running cycle count (the x86 time stamp counter), or
+ * zero where no such counter is available.
+ */
+double cpu_cycles(void);
+
+/* A named implementation of a primitive. */
+struct cpu_kernel {
+    const char *name;
+    unsigned long features; /* required CPU features */
+};
+
+/**
+ * Return the index of the first kernel, in a table ordered best
+ * first and terminated by a null name, that this CPU can run.
+ */
+int cpu_best(const struct cpu_kernel *kernels);
+
+/**
+ * Select the kernels for every primitive according to SPEC, a comma
+ * separated list of kernel names. A bare NAME applies to every
+ * primitive having a kernel by that name, while PRIMITIVE=NAME applies
+ * to just one primitive. Primitives not mentioned get their best
+ * kernel. A null SPEC selects the best kernels everywhere.
+ *
+ * Returns null on success, or a static error message.
+ */
+const char *cpu_select(const char *spec);
+
+/**
+ * Print each primitive and its kernels, one line per primitive,
+ * marking the current selection with an asterisk and parenthesizing
+ * kernels this CPU cannot run.
+ */
+void cpu_print(FILE *f);
+
+#endif /* CPU_H */
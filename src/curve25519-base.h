@@ -0,0 +1,929 @@
+#ifndef CURVE25519_BASE_H
+#define CURVE25519_BASE_H
+
+#include "../config.h"
+
+/* Precomputed multiples of the Ed25519 base point B = (x, 4/5), the
+ * twisted Edwards point corresponding to the Curve25519 base point
+ * u = 9, for fixed-base scalar multiplication:
+ *
+ *   curve25519_base[j][m - 1] = m * 16^(8j) * B,  0 <= j < 8, 1 <= m <= 8
+ *
+ * Each entry is (y + x, y - x, 2dxy) in affine coordinates, as fully
+ * reduced 32-byte little-endian field elements. */
+static const uint8_t curve25519_base[8][8][3][32] = {
+  { /* 16^0 B */
+    {
+      {0x85, 0x3b, 0x8c, 0xf5, 0xc6, 0x93, 0xbc, 0x2f,
+       0x19, 0x0e, 0x8c, 0xfb, 0xc6, 0x2d, 0x93, 0xcf,
+       0xc2, 0x42, 0x3d, 0x64, 0x98, 0x48, 0x0b, 0x27,
+       0x65, 0xba, 0xd4, 0x33, 0x3a, 0x9d, 0xcf, 0x07},
+      {0x3e, 0x91, 0x40, 0xd7, 0x05, 0x39, 0x10, 0x9d,
+       0xb3, 0xbe, 0x40, 0xd1, 0x05, 0x9f, 0x39, 0xfd,
+       0x09, 0x8a, 0x8f, 0x68, 0x34, 0x84, 0xc1, 0xa5,
+       0x67, 0x12, 0xf8, 0x98, 0x92, 0x2f, 0xfd, 0x44},
+      {0x68, 0xaa, 0x7a, 0x87, 0x05, 0x12, 0xc9, 0xab,
+       0x9e, 0xc4, 0xaa, 0xcc, 0x23, 0xe8, 0xd9, 0x26,
+       0x8c, 0x59, 0x43, 0xdd, 0xcb, 0x7d, 0x1b, 0x5a,
+       0xa8, 0x65, 0x0c, 0x9f, 0x68, 0x7b, 0x11, 0x6f}
+    },
+    {
+      {0xd7, 0x71, 0x3c, 0x93, 0xfc, 0xe7, 0x24, 0x92,
+       0xb5, 0xf5, 0x0f, 0x7a, 0x96, 0x9d, 0x46, 0x9f,
+       0x02, 0x07, 0xd6, 0xe1, 0x65, 0x9a, 0xa6, 0x5a,
+       0x2e, 0x2e, 0x7d, 0xa8, 0x3f, 0x06, 0x0c, 0x59},
+      {0xa8, 0xd5, 0xb4, 0x42, 0x60, 0xa5, 0x99, 0x8a,
+       0xf6, 0xac, 0x60, 0x4e, 0x0c, 0x81, 0x2b, 0x8f,
+       0xaa, 0x37, 0x6e, 0xb1, 0x6b, 0x23, 0x9e, 0xe0,
+       0x55, 0x25, 0xc9, 0x69, 0xa6, 0x95, 0xb5, 0x6b},
+      {0x5f, 0x7a, 0x9b, 0xa5, 0xb3, 0xa8, 0xfa, 0x43,
+       0x78, 0xcf, 0x9a, 0x5d, 0xdd, 0x6b, 0xc1, 0x36,
+       0x31, 0x6a, 0x3d, 0x0b, 0x84, 0xa0, 0x0f, 0x50,
+       0x73, 0x0b, 0xa5, 0x3e, 0xb1, 0xf5, 0x1a, 0x70}
+    },
+    {
+      {0x30, 0x97, 0xee, 0x4c, 0xa8, 0xb0, 0x25, 0xaf,
+       0x8a, 0x4b, 0x86, 0xe8, 0x30, 0x84, 0x5a, 0x02,
+       0x32, 0x67, 0x01, 0x9f, 0x02, 0x50, 0x1b, 0xc1,
+       0xf4, 0xf8, 0x80, 0x9a, 0x1b, 0x4e, 0x16, 0x7a},
+      {0x65, 0xd2, 0xfc, 0xa4, 0xe8, 0x1f, 0x61, 0x56,
+       0x7d, 0xba, 0xc1, 0xe5, 0xfd, 0x53, 0xd3, 0x3b,
+       0xbd, 0xd6, 0x4b, 0x21, 0x1a, 0xf3, 0x31, 0x81,
+       0x62, 0xda, 0x5b, 0x55, 0x87, 0x15, 0xb9, 0x2a},
+      {0x89, 0xd8, 0xd0, 0x0d, 0x3f, 0x93, 0xae, 0x14,
+       0x62, 0xda, 0x35, 0x1c, 0x22, 0x23, 0x94, 0x58,
+       0x4c, 0xdb, 0xf2, 0x8c, 0x45, 0xe5, 0x70, 0xd1,
+       0xc6, 0xb4, 0xb9, 0x12, 0xaf, 0x26, 0x28, 0x5a}
+    },
+    {
+      {0x9f, 0x09, 0xfc, 0x8e, 0xb9, 0x51, 0x73, 0x28,
+       0x38, 0x25, 0xfd, 0x7d, 0xf4, 0xc6, 0x65, 0x67,
+       0x65, 0x92, 0x0a, 0xfb, 0x3d, 0x8d, 0x34, 0xca,
+       0x27, 0x87, 0xe5, 0x21, 0x03, 0x91, 0x0e, 0x68},
+      {0xbf, 0x18, 0x68, 0x05, 0x0a, 0x05, 0xfe, 0x95,
+       0xa9, 0xfa, 0x60, 0x56, 0x71, 0x89, 0x7e, 0x32,
+       0x73, 0x50, 0xa0, 0x06, 0xcd, 0xe3, 0xe8, 0xc3,
+       0x9a, 0xa4, 0x45, 0x74, 0x4c, 0x3f, 0x93, 0x27},
+      {0x09, 0xff, 0x76, 0xc4, 0xe9, 0xfb, 0x13, 0x5a,
+       0x72, 0xc1, 0x5c, 0x7b, 0x45, 0x39, 0x9e, 0x6e,
+       0x94, 0x44, 0x2b, 0x10, 0xf9, 0xdc, 0xdb, 0x5d,
+       0x2b, 0x3e, 0x55, 0x63, 0xbf, 0x0c, 0x9d, 0x7f}
+    },
+    {
+      {0x33, 0xbb, 0xa5, 0x08, 0x44, 0xbc, 0x12, 0xa2,
+       0x02, 0xed, 0x5e, 0xc7, 0xc3, 0x48, 0x50, 0x8d,
+       0x44, 0xec, 0xbf, 0x5a, 0x0c, 0xeb, 0x1b, 0xdd,
+       0xeb, 0x06, 0xe2, 0x46, 0xf1, 0xcc, 0x45, 0x29},
+      {0xba, 0xd6, 0x47, 0xa4, 0xc3, 0x82, 0x91, 0x7f,
+       0xb7, 0x29, 0x27, 0x4b, 0xd1, 0x14, 0x00, 0xd5,
+       0x87, 0xa0, 0x64, 0xb8, 0x1c, 0xf1, 0x3c, 0xe3,
+       0xf3, 0x55, 0x1b, 0xeb, 0x73, 0x7e, 0x4a, 0x15},
+      {0x85, 0x82, 0x2a, 0x81, 0xf1, 0xdb, 0xbb, 0xbc,
+       0xfc, 0xd1, 0xbd, 0xd0, 0x07, 0x08, 0x0e, 0x27,
+       0x2d, 0xa7, 0xbd, 0x1b, 0x0b, 0x67, 0x1b, 0xb4,
+       0x9a, 0xb6, 0x3b, 0x6b, 0x69, 0xbe, 0xaa, 0x43}
+    },
+    {
+      {0x31, 0x71, 0x15, 0x77, 0xeb, 0xee, 0x0c, 0x3a,
+       0x88, 0xaf, 0xc8, 0x00, 0x89, 0x15, 0x27, 0x9b,
+       0x36, 0xa7, 0x59, 0xda, 0x68, 0xb6, 0x65, 0x80,
+       0xbd, 0x38, 0xcc, 0xa2, 0xb6, 0x7b, 0xe5, 0x51},
+      {0xa4, 0x8c, 0x7d, 0x7b, 0xb6, 0x06, 0x98, 0x49,
+       0x39, 0x27, 0xd2, 0x27, 0x84, 0xe2, 0x5b, 0x57,
+       0xb9, 0x53, 0x45, 0x20, 0xe7, 0x5c, 0x08, 0xbb,
+       0x84, 0x78, 0x41, 0xae, 0x41, 0x4c, 0xb6, 0x38},
+      {0x71, 0x4b, 0xea, 0x02, 0x67, 0x32, 0xac, 0x85,
+       0x01, 0xbb, 0xa1, 0x41, 0x03, 0xe0, 0x70, 0xbe,
+       0x44, 0xc1, 0x3b, 0x08, 0x4b, 0xa2, 0xe4, 0x53,
+       0xe3, 0x61, 0x0d, 0x9f, 0x1a, 0xe9, 0xb8, 0x10}
+    },
+    {
+      {0xbf, 0xa3, 0x4e, 0x94, 0xd0, 0x5c, 0x1a, 0x6b,
+       0xd2, 0xc0, 0x9d, 0xb3, 0x3a, 0x35, 0x70, 0x74,
+       0x49, 0x2e, 0x54, 0x28, 0x82, 0x52, 0xb2, 0x71,
+       0x7e, 0x92, 0x3c, 0x28, 0x69, 0xea, 0x1b, 0x46},
+      {0xb1, 0x21, 0x32, 0xaa, 0x9a, 0x2c, 0x6f, 0xba,
+       0xa7, 0x23, 0xba, 0x3b, 0x53, 0x21, 0xa0, 0x6c,
+       0x3a, 0x2c, 0x19, 0x92, 0x4f, 0x76, 0xea, 0x9d,
+       0xe0, 0x17, 0x53, 0x2e, 0x5d, 0xdd, 0x6e, 0x1d},
+      {0xa2, 0xb3, 0xb8, 0x01, 0xc8, 0x6d, 0x83, 0xf1,
+       0x9a, 0xa4, 0x3e, 0x05, 0x47, 0x5f, 0x03, 0xb3,
+       0xf3, 0xad, 0x77, 0x58, 0xba, 0x41, 0x9c, 0x52,
+       0xa7, 0x90, 0x0f, 0x6a, 0x1c, 0xbb, 0x9f, 0x7a}
+    },
+    {
+      {0x8f, 0x3e, 0xdd, 0x04, 0x66, 0x59, 0xb7, 0x59,
+       0x2c, 0x70, 0x88, 0xe2, 0x77, 0x03, 0xb3, 0x6c,
+       0x23, 0xc3, 0xd9, 0x5e, 0x66, 0x9c, 0x33, 0xb1,
+       0x2f, 0xe5, 0xbc, 0x61, 0x60, 0xe7, 0x15, 0x09},
+      {0xd9, 0x34, 0x92, 0xf3, 0xed, 0x5d, 0xa7, 0xe2,
+       0xf9, 0x58, 0xb5, 0xe1, 0x80, 0x76, 0x3d, 0x96,
+       0xfb, 0x23, 0x3c, 0x6e, 0xac, 0x41, 0x27, 0x2c,
+       0xc3, 0x01, 0x0e, 0x32, 0xa1, 0x24, 0x90, 0x3a},
+      {0x1a, 0x91, 0xa2, 0xc9, 0xd9, 0xf5, 0xc1, 0xe7,
+       0xd7, 0xa7, 0xcc, 0x8b, 0x78, 0x71, 0xa3, 0xb8,
+       0x32, 0x2a, 0xb6, 0x0e, 0x19, 0x12, 0x64, 0x63,
+       0x95, 0x4e, 0xcc, 0x2e, 0x5c, 0x7c, 0x90, 0x26}
+    }
+  },
+  { /* 16^8 B */
+    {
+      {0xe8, 0xc5, 0x85, 0x7b, 0x9f, 0xb6, 0x65, 0x87,
+       0xb2, 0xba, 0x68, 0xd1, 0x8b, 0x67, 0xf0, 0x6f,
+       0x9b, 0x0f, 0x33, 0x1d, 0x7c, 0xe7, 0x70, 0x3a,
+       0x7c, 0x8e, 0xaf, 0xb0, 0x51, 0x6d, 0x5f, 0x3a},
+      {0x5f, 0xac, 0x0d, 0xa6, 0x56, 0x87, 0x36, 0x61,
+       0x57, 0xdc, 0xab, 0xeb, 0x6a, 0x2f, 0xe0, 0x17,
+       0x7d, 0x0f, 0xce, 0x4c, 0x2d, 0x3f, 0x19, 0x7f,
+       0xf0, 0xdc, 0xec, 0x89, 0x77, 0x4a, 0x23, 0x20},
+      {0x52, 0xb2, 0x78, 0x71, 0xb6, 0x0d, 0xd2, 0x76,
+       0x60, 0xd1, 0x1e, 0xd5, 0xf9, 0x34, 0x1c, 0x07,
+       0x70, 0x11, 0xe4, 0xb3, 0x20, 0x4a, 0x2a, 0xf6,
+       0x66, 0xe3, 0xff, 0x3c, 0x35, 0x82, 0xd6, 0x7c}
+    },
+    {
+      {0xf3, 0xf4, 0xac, 0x68, 0x60, 0xcd, 0x65, 0xa6,
+       0xd3, 0xe3, 0xd7, 0x3c, 0x18, 0x2d, 0xd9, 0x42,
+       0xd9, 0x25, 0x60, 0x33, 0x9d, 0x38, 0x59, 0x57,
+       0xff, 0xd8, 0x2c, 0x2b, 0x3b, 0x25, 0xf0, 0x3e},
+      {0xb6, 0xfa, 0x87, 0xd8, 0x5b, 0xa4, 0xe1, 0x0b,
+       0x6e, 0x3b, 0x40, 0xba, 0x32, 0x6a, 0x84, 0x2a,
+       0x00, 0x60, 0x6e, 0xe9, 0x12, 0x10, 0x92, 0xd9,
+       0x43, 0x09, 0xdc, 0x3b, 0x86, 0xc8, 0x38, 0x28},
+      {0x30, 0x50, 0x46, 0x4a, 0xcf, 0xb0, 0x6b, 0xd1,
+       0xab, 0x77, 0xc5, 0x15, 0x41, 0x6b, 0x49, 0xfa,
+       0x9d, 0x41, 0xab, 0xf4, 0x8a, 0xae, 0xcf, 0x82,
+       0x12, 0x28, 0xa8, 0x06, 0xa6, 0xb8, 0xdc, 0x21}
+    },
+    {
+      {0xba, 0x31, 0x77, 0xbe, 0xfa, 0x00, 0x8d, 0x9a,
+       0x89, 0x18, 0x9e, 0x62, 0x7e, 0x60, 0x03, 0x82,
+       0x7f, 0xd9, 0xf3, 0x43, 0x37, 0x02, 0xcc, 0xb2,
+       0x8b, 0x67, 0x6f, 0x6c, 0xbf, 0x0d, 0x84, 0x5d},
+      {0xc8, 0x9f, 0x9d, 0x8c, 0x46, 0x04, 0x60, 0x5c,
+       0xcb, 0xa3, 0x2a, 0xd4, 0x6e, 0x09, 0x40, 0x25,
+       0x9c, 0x2f, 0xee, 0x12, 0x4c, 0x4d, 0x5b, 0x12,
+       0xab, 0x1d, 0xa3, 0x94, 0x81, 0xd0, 0xc3, 0x0b},
+      {0x8b, 0xe1, 0x9f, 0x30, 0x0d, 0x38, 0x6e, 0x70,
+       0xc7, 0x65, 0xe1, 0xb9, 0xa6, 0x2d, 0xb0, 0x6e,
+       0xab, 0x20, 0xae, 0x7d, 0x99, 0xba, 0xbb, 0x57,
+       0xdd, 0x96, 0xc1, 0x2a, 0x23, 0x76, 0x42, 0x3a}
+    },
+    {
+      {0xcb, 0x7e, 0x44, 0xdb, 0x72, 0xc1, 0xf8, 0x3b,
+       0xbd, 0x2d, 0x28, 0xc6, 0x1f, 0xc4, 0xcf, 0x5f,
+       0xfe, 0x15, 0xaa, 0x75, 0xc0, 0xff, 0xac, 0x80,
+       0xf9, 0xa9, 0xe1, 0x24, 0xe8, 0xc9, 0x70, 0x07},
+      {0xfa, 0x84, 0x70, 0x8a, 0x2c, 0x43, 0x42, 0x4b,
+       0x45, 0xe5, 0xb9, 0xdf, 0xe3, 0x19, 0x8a, 0x89,
+       0x5d, 0xe4, 0x58, 0x9c, 0x21, 0x00, 0x9f, 0xbe,
+       0xd1, 0xeb, 0x6d, 0xa1, 0xce, 0x77, 0xf1, 0x1f},
+      {0xfd, 0xb5, 0xb5, 0x45, 0x9a, 0xd9, 0x61, 0xcf,
+       0x24, 0x79, 0x3a, 0x1b, 0xe9, 0x84, 0x09, 0x86,
+       0x89, 0x3e, 0x3e, 0x30, 0x19, 0x09, 0x30, 0xe7,
+       0x1e, 0x0b, 0x50, 0x41, 0xfd, 0x64, 0xf2, 0x39}
+    },
+    {
+      {0xe1, 0x7b, 0x09, 0xfe, 0xab, 0x4a, 0x9b, 0xd1,
+       0x29, 0x19, 0xe0, 0xdf, 0xe1, 0xfc, 0x6d, 0xa4,
+       0xff, 0xf1, 0xa6, 0x2c, 0x94, 0x08, 0xc9, 0xc3,
+       0x4e, 0xf1, 0x35, 0x2c, 0x27, 0x21, 0xc6, 0x65},
+      {0x9c, 0xe2, 0xe7, 0xdb, 0x17, 0x34, 0xad, 0xa7,
+       0x9c, 0x13, 0x9c, 0x2b, 0x6a, 0x37, 0x94, 0xbd,
+       0xa9, 0x7b, 0x59, 0x93, 0x8e, 0x1b, 0xe9, 0xa0,
+       0x40, 0x98, 0x88, 0x68, 0x34, 0xd7, 0x12, 0x17},
+      {0xdd, 0x93, 0x31, 0xce, 0xf8, 0x89, 0x2b, 0xe7,
+       0xbb, 0xc0, 0x25, 0xa1, 0x56, 0x33, 0x10, 0x4d,
+       0x83, 0xfe, 0x1c, 0x2e, 0x3d, 0xa9, 0x19, 0x04,
+       0x72, 0xe2, 0x9c, 0xb1, 0x0a, 0x80, 0xf9, 0x22}
+    },
+    {
+      {0xac, 0xfd, 0x6e, 0x9a, 0xdd, 0x9f, 0x02, 0x42,
+       0x41, 0x49, 0xa5, 0x34, 0xbe, 0xce, 0x12, 0xb9,
+       0x7b, 0xf3, 0xbd, 0x87, 0xb9, 0x64, 0x0f, 0x64,
+       0xb4, 0xca, 0x98, 0x85, 0xd3, 0xa4, 0x71, 0x41},
+      {0xcb, 0xf8, 0x9e, 0x3e, 0x8a, 0x36, 0x5a, 0x60,
+       0x15, 0x47, 0x50, 0xa5, 0x22, 0xc0, 0xe9, 0xe3,
+       0x8f, 0x24, 0x24, 0x5f, 0xb0, 0x48, 0x3d, 0x55,
+       0xe5, 0x26, 0x76, 0x64, 0xcd, 0x16, 0xf4, 0x13},
+      {0x8c, 0x4c, 0xc9, 0x99, 0xaa, 0x58, 0x27, 0xfa,
+       0x07, 0xb8, 0x00, 0xb0, 0x6f, 0x6f, 0x00, 0x23,
+       0x92, 0x53, 0xda, 0xad, 0xdd, 0x91, 0xd2, 0xfb,
+       0xab, 0xd1, 0x4b, 0x57, 0xfa, 0x14, 0x82, 0x50}
+    },
+    {
+      {0xd6, 0x03, 0xd0, 0x53, 0xbb, 0x15, 0x1a, 0x46,
+       0x65, 0xc9, 0xf3, 0xbc, 0x88, 0x28, 0x10, 0xb2,
+       0x5a, 0x3a, 0x68, 0x6c, 0x75, 0x76, 0xc5, 0x27,
+       0x47, 0xb4, 0x6c, 0xc8, 0xa4, 0x58, 0x77, 0x3a},
+      {0x4b, 0xfe, 0xd6, 0x3e, 0x15, 0x69, 0x02, 0xc2,
+       0xc4, 0x77, 0x1d, 0x51, 0x39, 0x67, 0x5a, 0xa6,
+       0x94, 0xaf, 0x14, 0x2c, 0x46, 0x26, 0xde, 0xcb,
+       0x4b, 0xa7, 0xab, 0x6f, 0xec, 0x60, 0xf9, 0x22},
+      {0x76, 0x50, 0xae, 0x93, 0xf6, 0x11, 0x81, 0x54,
+       0xa6, 0x54, 0xfd, 0x1d, 0xdf, 0x21, 0xae, 0x1d,
+       0x65, 0x5e, 0x11, 0xf3, 0x90, 0x8c, 0x24, 0x12,
+       0x94, 0xf4, 0xe7, 0x8d, 0x5f, 0xd1, 0x9f, 0x5d}
+    },
+    {
+      {0x1e, 0x52, 0xd7, 0xee, 0x2a, 0x4d, 0x24, 0x3f,
+       0x15, 0x96, 0x2e, 0x43, 0x28, 0x90, 0x3a, 0x8e,
+       0xd4, 0x16, 0x9c, 0x2e, 0x77, 0xba, 0x64, 0xe1,
+       0xd8, 0x98, 0xeb, 0x47, 0xfa, 0x87, 0xc1, 0x3b},
+      {0x7f, 0x72, 0x63, 0x6d, 0xd3, 0x08, 0x14, 0x03,
+       0x33, 0xb5, 0xc7, 0xd7, 0xef, 0x9a, 0x37, 0x6a,
+       0x4b, 0xe2, 0xae, 0xcc, 0xc5, 0x8f, 0xe1, 0xa9,
+       0xd3, 0xbe, 0x8f, 0x4f, 0x91, 0x35, 0x2f, 0x33},
+      {0x0c, 0xc2, 0x86, 0xea, 0x15, 0x01, 0x47, 0x6d,
+       0x25, 0xd1, 0x46, 0x6c, 0xcb, 0xb7, 0x8a, 0x99,
+       0x88, 0x01, 0x66, 0x3a, 0xb5, 0x32, 0x78, 0xd7,
+       0x03, 0xba, 0x6f, 0x90, 0xce, 0x81, 0x0d, 0x45}
+    }
+  },
+  { /* 16^16 B */
+    {
+      {0x15, 0xf5, 0xd1, 0x77, 0xe7, 0x65, 0x2a, 0xcd,
+       0xf1, 0x60, 0xaa, 0x8f, 0x87, 0x91, 0x89, 0x54,
+       0xe5, 0x06, 0xbc, 0xda, 0xbc, 0x3b, 0xb7, 0xb1,
+       0xfb, 0xc9, 0x7c, 0xa9, 0xcb, 0x78, 0x48, 0x65},
+      {0xfe, 0xb0, 0xf6, 0x8d, 0xc7, 0x8e, 0x13, 0x51,
+       0x1b, 0xf5, 0x75, 0xe5, 0x89, 0xda, 0x97, 0x53,
+       0xb9, 0xf1, 0x7a, 0x71, 0x1d, 0x7a, 0x20, 0x09,
+       0x50, 0xd6, 0x20, 0x2b, 0xba, 0xfd, 0x02, 0x21},
+      {0xa1, 0xe6, 0x5c, 0x05, 0x05, 0xe4, 0x9e, 0x96,
+       0x29, 0xad, 0x51, 0x12, 0x68, 0xa7, 0xbc, 0x36,
+       0x15, 0xa4, 0x7d, 0xaa, 0x17, 0xf5, 0x1a, 0x3a,
+       0xba, 0xb2, 0xec, 0x29, 0xdb, 0x25, 0xd7, 0x0a}
+    },
+    {
+      {0x85, 0x6f, 0x05, 0x9b, 0x0c, 0xbc, 0xc7, 0xfe,
+       0xd7, 0xff, 0xf5, 0xe7, 0x68, 0x52, 0x7d, 0x53,
+       0xfa, 0xae, 0x12, 0x43, 0x62, 0xc6, 0xaf, 0x77,
+       0xd9, 0x9f, 0x39, 0x02, 0x53, 0x5f, 0x67, 0x4f},
+      {0x57, 0x24, 0x4e, 0x83, 0xb1, 0x67, 0x42, 0xdc,
+       0xc5, 0x1b, 0xce, 0x70, 0xb5, 0x44, 0x75, 0xb6,
+       0xd7, 0x5e, 0xd1, 0xf7, 0x0b, 0x7a, 0xf0, 0x1a,
+       0x50, 0x36, 0xa0, 0x71, 0xfb, 0xcf, 0xef, 0x4a},
+      {0x1e, 0x17, 0x15, 0x04, 0x36, 0x36, 0x2d, 0xc3,
+       0x3b, 0x48, 0x98, 0x89, 0x11, 0xef, 0x2b, 0xcd,
+       0x10, 0x51, 0x94, 0xd0, 0xad, 0x6e, 0x0a, 0x87,
+       0x61, 0x65, 0xa8, 0xa2, 0x72, 0xbb, 0xcc, 0x0b}
+    },
+    {
+      {0x96, 0x12, 0xfe, 0x50, 0x4c, 0x5e, 0x6d, 0x18,
+       0x7e, 0x9f, 0xe8, 0xfe, 0x82, 0x7b, 0x39, 0xe0,
+       0xb0, 0x31, 0x70, 0x50, 0xc5, 0xf6, 0xc7, 0x3b,
+       0xc2, 0x37, 0x8f, 0x10, 0x69, 0xfd, 0x78, 0x66},
+      {0xc8, 0xa9, 0xb1, 0xea, 0x2f, 0x96, 0x5e, 0x18,
+       0xcd, 0x7d, 0x14, 0x65, 0x35, 0xe6, 0xe7, 0x86,
+       0xf2, 0x6d, 0x5b, 0xbb, 0x31, 0xe0, 0x92, 0xb0,
+       0x3e, 0xb7, 0xd6, 0x59, 0xab, 0xf0, 0x24, 0x40},
+      {0xc2, 0x63, 0x68, 0x63, 0x31, 0xfa, 0x86, 0x15,
+       0xf2, 0x33, 0x2d, 0x57, 0x48, 0x8c, 0xf6, 0x07,
+       0xfc, 0xae, 0x9e, 0x78, 0x9f, 0xcc, 0x73, 0x4f,
+       0x01, 0x47, 0xad, 0x8e, 0x10, 0xe2, 0x42, 0x2d}
+    },
+    {
+      {0x93, 0x75, 0x53, 0x0f, 0x0d, 0x7b, 0x71, 0x21,
+       0x4c, 0x06, 0x1e, 0x13, 0x0b, 0x69, 0x4e, 0x91,
+       0x9f, 0xe0, 0x2a, 0x75, 0xae, 0x87, 0xb6, 0x1b,
+       0x6e, 0x3c, 0x42, 0x9b, 0xa7, 0xf3, 0x0b, 0x42},
+      {0x9b, 0xd2, 0xdf, 0x94, 0x15, 0x13, 0xf5, 0x97,
+       0x6a, 0x4c, 0x3f, 0x31, 0x5d, 0x98, 0x55, 0x61,
+       0x10, 0x50, 0x45, 0x08, 0x07, 0x3f, 0xa1, 0xeb,
+       0x22, 0xd3, 0xd2, 0xb8, 0x08, 0x26, 0x6b, 0x67},
+      {0x47, 0x2b, 0x5b, 0x1c, 0x65, 0xba, 0x38, 0x81,
+       0x80, 0x1b, 0x1b, 0x31, 0xec, 0xb6, 0x71, 0x86,
+       0xb0, 0x35, 0x31, 0xbc, 0xb1, 0x0c, 0xff, 0x7b,
+       0xe0, 0xf1, 0x0c, 0x9c, 0xfa, 0x2f, 0x5d, 0x74}
+    },
+    {
+      {0x6a, 0x4e, 0xd3, 0x21, 0x57, 0xdf, 0x36, 0x60,
+       0xd0, 0xb3, 0x7b, 0x99, 0x27, 0x88, 0xdb, 0xb1,
+       0xfa, 0x6a, 0x75, 0xc8, 0xc3, 0x09, 0xc2, 0xd3,
+       0x39, 0xc8, 0x1d, 0x4c, 0xe5, 0x5b, 0xe1, 0x06},
+      {0xbd, 0xc8, 0xc9, 0x2b, 0x1e, 0x5a, 0x52, 0xbf,
+       0x81, 0x9d, 0x47, 0x26, 0x08, 0x26, 0x5b, 0xea,
+       0xdb, 0x55, 0x01, 0xdf, 0x0e, 0xc7, 0x11, 0xd5,
+       0xd0, 0xf5, 0x0c, 0x96, 0xeb, 0x3c, 0xe2, 0x1a},
+      {0x4a, 0x99, 0x32, 0x19, 0x87, 0x5d, 0x72, 0x5b,
+       0xb0, 0xda, 0xb1, 0xce, 0xb5, 0x1c, 0x35, 0x32,
+       0x05, 0xca, 0xb7, 0xda, 0x49, 0x15, 0xc4, 0x7d,
+       0xf7, 0xc1, 0x8e, 0x27, 0x61, 0xd8, 0xde, 0x58}
+    },
+    {
+      {0xa8, 0xc9, 0xc2, 0xb6, 0xa8, 0x5b, 0xfb, 0x2d,
+       0x8c, 0x59, 0x2c, 0xf5, 0x8e, 0xef, 0xee, 0x48,
+       0x73, 0x15, 0x2d, 0xf1, 0x07, 0x91, 0x80, 0x33,
+       0xd8, 0x5b, 0x1d, 0x53, 0x6b, 0x69, 0xba, 0x08},
+      {0x5c, 0xc5, 0x66, 0xf2, 0x93, 0x37, 0x17, 0xd8,
+       0x49, 0x4e, 0x45, 0xcc, 0xc5, 0x76, 0xc9, 0xc8,
+       0xa8, 0xc3, 0x26, 0xbc, 0xf8, 0x82, 0xe3, 0x5c,
+       0xf9, 0xf6, 0x85, 0x54, 0xe8, 0x9d, 0xf3, 0x2f},
+      {0x7a, 0xc5, 0xef, 0xc3, 0xee, 0x3e, 0xed, 0x77,
+       0x11, 0x48, 0xff, 0xd4, 0x17, 0x55, 0xe0, 0x04,
+       0xcb, 0x71, 0xa6, 0xf1, 0x3f, 0x7a, 0x3d, 0xea,
+       0x54, 0xfe, 0x7c, 0x94, 0xb4, 0x33, 0x06, 0x12}
+    },
+    {
+      {0x0a, 0x10, 0x12, 0x49, 0x47, 0x31, 0xbd, 0x82,
+       0x06, 0xbe, 0x6f, 0x7e, 0x6d, 0x7b, 0x23, 0xde,
+       0xc6, 0x79, 0xea, 0x11, 0x19, 0x76, 0x1e, 0xe1,
+       0xde, 0x3b, 0x39, 0xcb, 0xe3, 0x3b, 0x43, 0x07},
+      {0x42, 0x00, 0x61, 0x91, 0x78, 0x98, 0x94, 0x0b,
+       0xe8, 0xfa, 0xeb, 0xec, 0x3c, 0xb1, 0xe7, 0x4e,
+       0xc0, 0xa4, 0xf0, 0x94, 0x95, 0x73, 0xbe, 0x70,
+       0x85, 0x91, 0xd5, 0xb4, 0x99, 0x0a, 0xd3, 0x35},
+      {0xf4, 0x97, 0xe9, 0x5c, 0xc0, 0x44, 0x79, 0xff,
+       0xa3, 0x51, 0x5c, 0xb0, 0xe4, 0x3d, 0x5d, 0x57,
+       0x7c, 0x84, 0x76, 0x5a, 0xfd, 0x81, 0x33, 0x58,
+       0x9f, 0xda, 0xf6, 0x7a, 0xde, 0x3e, 0x87, 0x2d}
+    },
+    {
+      {0x81, 0xf9, 0x5d, 0x4e, 0xe1, 0x02, 0x62, 0xaa,
+       0xf5, 0xe1, 0x15, 0x50, 0x17, 0x59, 0x0d, 0xa2,
+       0x6c, 0x1d, 0xe2, 0xba, 0xd3, 0x75, 0xa2, 0x18,
+       0x53, 0x02, 0x60, 0x01, 0x8a, 0x61, 0x43, 0x05},
+      {0x09, 0x34, 0x37, 0x43, 0x64, 0x31, 0x7a, 0x15,
+       0xd9, 0x81, 0xaa, 0xf4, 0xee, 0xb7, 0xb8, 0xfa,
+       0x06, 0x48, 0xa6, 0xf5, 0xe6, 0xfe, 0x93, 0xb0,
+       0xb6, 0xa7, 0x7f, 0x70, 0x54, 0x36, 0x77, 0x2e},
+      {0xc1, 0x23, 0x4c, 0x97, 0xf4, 0xbd, 0xea, 0x0d,
+       0x93, 0x46, 0xce, 0x9d, 0x25, 0x0a, 0x6f, 0xaa,
+       0x2c, 0xba, 0x9a, 0xa2, 0xb8, 0x2c, 0x20, 0x04,
+       0x0d, 0x96, 0x07, 0x2d, 0x36, 0x43, 0x14, 0x4b}
+    }
+  },
+  { /* 16^24 B */
+    {
+      {0xa4, 0xb0, 0xdd, 0x12, 0x9c, 0x63, 0x98, 0xd5,
+       0x6b, 0x86, 0x24, 0xc0, 0x30, 0x9f, 0xd1, 0xa5,
+       0x60, 0xe4, 0xfc, 0x58, 0x03, 0x2f, 0x7c, 0xd1,
+       0x8a, 0x5e, 0x09, 0x2e, 0x15, 0x95, 0xa1, 0x07},
+      {0xde, 0xc4, 0x2e, 0x9c, 0xc5, 0xa9, 0x6f, 0x29,
+       0xcb, 0xf3, 0x84, 0x4f, 0xbf, 0x61, 0x8b, 0xbc,
+       0x08, 0xf9, 0xa8, 0x17, 0xd9, 0x06, 0x77, 0x1c,
+       0x5d, 0x25, 0xd3, 0x7a, 0xfc, 0x95, 0xb7, 0x63},
+      {0xc8, 0x5f, 0x9e, 0x38, 0x02, 0x8f, 0x36, 0xa8,
+       0x3b, 0xe4, 0x8d, 0xcf, 0x02, 0x3b, 0x43, 0x90,
+       0x43, 0x26, 0x41, 0xc5, 0x5d, 0xfd, 0xa1, 0xaf,
+       0x37, 0x01, 0x2f, 0x03, 0x3d, 0xe8, 0x8f, 0x3e}
+    },
+    {
+      {0x3c, 0xd1, 0xef, 0xe8, 0x8d, 0x4c, 0x70, 0x08,
+       0x31, 0x37, 0xe0, 0x33, 0x8e, 0x1a, 0xc5, 0xdf,
+       0xe3, 0xcd, 0x60, 0x12, 0xa5, 0x5d, 0x9d, 0xa5,
+       0x86, 0x8c, 0x25, 0xa6, 0x99, 0x08, 0xd6, 0x22},
+      {0x94, 0xa2, 0x70, 0x05, 0xb9, 0x15, 0x8b, 0x2f,
+       0x49, 0x45, 0x08, 0x67, 0x70, 0x42, 0xf2, 0x94,
+       0x84, 0xfd, 0xbb, 0x61, 0xe1, 0x5a, 0x1c, 0xde,
+       0x07, 0x40, 0xac, 0x7f, 0x79, 0x3b, 0xba, 0x75},
+      {0x96, 0xd1, 0xcd, 0x70, 0xc0, 0xdb, 0x39, 0x62,
+       0x9a, 0x8a, 0x7d, 0x6c, 0x8b, 0x8a, 0xfe, 0x60,
+       0x60, 0x12, 0x40, 0xeb, 0xbc, 0x47, 0x88, 0xb3,
+       0x5e, 0x9e, 0x77, 0x87, 0x7b, 0xd0, 0x04, 0x09}
+    },
+    {
+      {0xb9, 0x40, 0xf9, 0x48, 0x66, 0x2d, 0x32, 0xf4,
+       0x39, 0x0c, 0x2d, 0xbd, 0x0c, 0x2f, 0x95, 0x06,
+       0x31, 0xf9, 0x81, 0xa0, 0xad, 0x97, 0x76, 0x16,
+       0x6c, 0x2a, 0xf7, 0xba, 0xce, 0xaa, 0x40, 0x62},
+      {0x9c, 0x91, 0xba, 0xdd, 0xd4, 0x1f, 0xce, 0xb4,
+       0xaa, 0x8d, 0x4c, 0xc7, 0x3e, 0xdb, 0x31, 0xcf,
+       0x51, 0xcc, 0x86, 0xad, 0x63, 0xcc, 0x63, 0x2c,
+       0x07, 0xde, 0x1d, 0xbc, 0x3f, 0x14, 0xe2, 0x43},
+      {0xa0, 0x95, 0xa2, 0x5b, 0x9c, 0x74, 0x34, 0xf8,
+       0x5a, 0xd2, 0x37, 0xca, 0x5b, 0x7c, 0x94, 0xd6,
+       0x6a, 0x31, 0xc9, 0xe7, 0xa7, 0x3b, 0xf1, 0x66,
+       0xac, 0x0c, 0xb4, 0x8d, 0x23, 0xaf, 0xbd, 0x56}
+    },
+    {
+      {0xb2, 0x3b, 0x9d, 0xc1, 0x6c, 0xd3, 0x10, 0x13,
+       0xb9, 0x86, 0x23, 0x62, 0xb7, 0x6b, 0x2a, 0x06,
+       0x5c, 0x4f, 0xa1, 0xd7, 0x91, 0x85, 0x9b, 0x7c,
+       0x54, 0x57, 0x1e, 0x7e, 0x50, 0x31, 0xaa, 0x03},
+      {0xeb, 0x33, 0x35, 0xf5, 0xe3, 0xb9, 0x2a, 0x36,
+       0x40, 0x3d, 0xb9, 0x6e, 0xd5, 0x68, 0x85, 0x33,
+       0x72, 0x55, 0x5a, 0x1d, 0x52, 0x14, 0x0e, 0x9e,
+       0x18, 0x13, 0x74, 0x83, 0x6d, 0xa8, 0x24, 0x1d},
+      {0x1f, 0xce, 0xd4, 0xff, 0x48, 0x76, 0xec, 0xf4,
+       0x1c, 0x8c, 0xac, 0x54, 0xf0, 0xea, 0x45, 0xe0,
+       0x7c, 0x35, 0x09, 0x1d, 0x82, 0x25, 0xd2, 0x88,
+       0x59, 0x48, 0xeb, 0x9a, 0xdc, 0x61, 0xb2, 0x43}
+    },
+    {
+      {0x64, 0x13, 0x95, 0x6c, 0x8b, 0x3d, 0x51, 0x19,
+       0x7b, 0xf4, 0x0b, 0x00, 0x26, 0x71, 0xfe, 0x94,
+       0x67, 0x95, 0x4f, 0xd5, 0xdd, 0x10, 0x8d, 0x02,
+       0x64, 0x09, 0x94, 0x42, 0xe2, 0xd5, 0xb4, 0x02},
+      {0xbb, 0x79, 0xbb, 0x88, 0x19, 0x1e, 0x5b, 0xe5,
+       0x9d, 0x35, 0x7a, 0xc1, 0x7d, 0xd0, 0x9e, 0xa0,
+       0x33, 0xea, 0x3d, 0x60, 0xe2, 0x2e, 0x2c, 0xb0,
+       0xc2, 0x6b, 0x27, 0x5b, 0xcf, 0x55, 0x60, 0x32},
+      {0xf2, 0x8d, 0xd1, 0x28, 0xcb, 0x55, 0xa1, 0xb4,
+       0x08, 0xe5, 0x6c, 0x18, 0x46, 0x46, 0xcc, 0xea,
+       0x89, 0x43, 0x82, 0x6c, 0x93, 0xf4, 0x9c, 0xc4,
+       0x10, 0x34, 0x5d, 0xae, 0x09, 0xc8, 0xa6, 0x27}
+    },
+    {
+      {0x54, 0x69, 0x3d, 0xc4, 0x0a, 0x27, 0x2c, 0xcd,
+       0xb2, 0xca, 0x66, 0x6a, 0x57, 0x3e, 0x4a, 0xdd,
+       0x6c, 0x03, 0xd7, 0x69, 0x24, 0x59, 0xfa, 0x79,
+       0x99, 0x25, 0x8c, 0x3d, 0x60, 0x03, 0x15, 0x22},
+      {0x88, 0xb1, 0x0d, 0x1f, 0xcd, 0xeb, 0xa6, 0x8b,
+       0xe8, 0x5b, 0x5a, 0x67, 0x3a, 0xd7, 0xd3, 0x37,
+       0x5a, 0x58, 0xf5, 0x15, 0xa3, 0xdf, 0x2e, 0xf2,
+       0x7e, 0xa1, 0x60, 0xff, 0x74, 0x71, 0xb6, 0x2c},
+      {0xd0, 0xe1, 0x0b, 0x39, 0xf9, 0xcd, 0xee, 0x59,
+       0xf1, 0xe3, 0x8c, 0x72, 0x44, 0x20, 0x42, 0xa9,
+       0xf4, 0xf0, 0x94, 0x7a, 0x66, 0x1c, 0x89, 0x82,
+       0x36, 0xf4, 0x90, 0x38, 0xb7, 0xf4, 0x1d, 0x7b}
+    },
+    {
+      {0x8c, 0xf5, 0xf8, 0x07, 0x18, 0x22, 0x2e, 0x5f,
+       0xd4, 0x09, 0x94, 0xd4, 0x9f, 0x5c, 0x55, 0xe3,
+       0x30, 0xa6, 0xb6, 0x1f, 0x8d, 0xa8, 0xaa, 0xb2,
+       0x3d, 0xe0, 0x52, 0xd3, 0x45, 0x82, 0x69, 0x68},
+      {0x24, 0xa2, 0xb2, 0xb3, 0xe0, 0xf2, 0x92, 0xe4,
+       0x60, 0x11, 0x55, 0x2b, 0x06, 0x9e, 0x6c, 0x7c,
+       0x0e, 0x7b, 0x7f, 0x0d, 0xe2, 0x8f, 0xeb, 0x15,
+       0x92, 0x59, 0xfc, 0x58, 0x26, 0xef, 0xfc, 0x61},
+      {0x7a, 0x18, 0x18, 0x2a, 0x85, 0x5d, 0xb1, 0xdb,
+       0xd7, 0xac, 0xdd, 0x86, 0xd3, 0xaa, 0xe4, 0xf3,
+       0x82, 0xc4, 0xf6, 0x0f, 0x81, 0xe2, 0xba, 0x44,
+       0xcf, 0x01, 0xaf, 0x3d, 0x47, 0x4c, 0xcf, 0x46}
+    },
+    {
+      {0x40, 0x81, 0x49, 0xf1, 0xa7, 0x6e, 0x3c, 0x21,
+       0x54, 0x48, 0x2b, 0x39, 0xf8, 0x7e, 0x1e, 0x7c,
+       0xba, 0xce, 0x29, 0x56, 0x8c, 0xc3, 0x88, 0x24,
+       0xbb, 0xc5, 0x8c, 0x0d, 0xe5, 0xaa, 0x65, 0x10},
+      {0xf9, 0xe5, 0xc4, 0x9e, 0xed, 0x25, 0x65, 0x42,
+       0x03, 0x33, 0x90, 0x16, 0x01, 0xda, 0x5e, 0x0e,
+       0xdc, 0xca, 0xe5, 0xcb, 0xf2, 0xa7, 0xb1, 0x72,
+       0x40, 0x5f, 0xeb, 0x14, 0xcd, 0x7b, 0x38, 0x29},
+      {0x57, 0x0d, 0x20, 0xdf, 0x25, 0x45, 0x2c, 0x1c,
+       0x4a, 0x67, 0xca, 0xbf, 0xd6, 0x2d, 0x3b, 0x5c,
+       0x30, 0x40, 0x83, 0xe1, 0xb1, 0xe7, 0x07, 0x0a,
+       0x16, 0xe7, 0x1c, 0x4f, 0xe6, 0x98, 0xa1, 0x69}
+    }
+  },
+  { /* 16^32 B */
+    {
+      {0xa2, 0x8e, 0xad, 0xac, 0xbf, 0x04, 0x3b, 0x58,
+       0x84, 0xe8, 0x8b, 0x14, 0xe8, 0x43, 0xb7, 0x29,
+       0xdb, 0xc5, 0x10, 0x08, 0x3b, 0x58, 0x1e, 0x2b,
+       0xaa, 0xbb, 0xb3, 0x8e, 0xe5, 0x49, 0x54, 0x2b},
+      {0x47, 0xbe, 0x3d, 0xeb, 0x62, 0x75, 0x3a, 0x5f,
+       0xb8, 0xa0, 0xbd, 0x8e, 0x54, 0x38, 0xea, 0xf7,
+       0x99, 0x72, 0x74, 0x45, 0x31, 0xe5, 0xc3, 0x00,
+       0x51, 0xd5, 0x27, 0x16, 0xe7, 0xe9, 0x04, 0x13},
+      {0xfe, 0x9c, 0xdc, 0x6a, 0xd2, 0x14, 0x98, 0x78,
+       0x0b, 0xdd, 0x48, 0x8b, 0x3f, 0xab, 0x1b, 0x3c,
+       0x0a, 0xc6, 0x79, 0xf9, 0xff, 0xe1, 0x0f, 0xda,
+       0x93, 0xd6, 0x2d, 0x7c, 0x2d, 0xde, 0x68, 0x44}
+    },
+    {
+      {0xce, 0x07, 0x63, 0xf8, 0xc6, 0xd8, 0x9a, 0x4b,
+       0x28, 0x0c, 0x5d, 0x43, 0x31, 0x35, 0x11, 0x21,
+       0x2c, 0x77, 0x7a, 0x65, 0xc5, 0x66, 0xa8, 0xd4,
+       0x52, 0x73, 0x24, 0x63, 0x7e, 0x42, 0xa6, 0x5d},
+      {0x9e, 0x46, 0x19, 0x94, 0x5e, 0x35, 0xbb, 0x51,
+       0x54, 0xc7, 0xdd, 0x23, 0x4c, 0xdc, 0xe6, 0x33,
+       0x62, 0x99, 0x7f, 0x44, 0xd6, 0xb6, 0xa5, 0x93,
+       0x63, 0xbd, 0x44, 0xfb, 0x6f, 0x7c, 0xce, 0x6c},
+      {0xca, 0x22, 0xac, 0xde, 0x88, 0xc6, 0x94, 0x1a,
+       0xf8, 0x1f, 0xae, 0xbb, 0xf7, 0x6e, 0x06, 0xb9,
+       0x0f, 0x58, 0x59, 0x8d, 0x38, 0x8c, 0xad, 0x88,
+       0xa8, 0x2c, 0x9f, 0xe7, 0xbf, 0x9a, 0xf2, 0x58}
+    },
+    {
+      {0xf6, 0xcd, 0x0e, 0x71, 0xbf, 0x64, 0x5a, 0x4b,
+       0x3c, 0x29, 0x2c, 0x46, 0x38, 0xe5, 0x4c, 0xb1,
+       0xb9, 0x3a, 0x0b, 0xd5, 0x56, 0xd0, 0x43, 0x36,
+       0x70, 0x48, 0x5b, 0x18, 0x24, 0x37, 0xf9, 0x6a},
+      {0x68, 0x3e, 0xe7, 0x8d, 0xab, 0xcf, 0x0e, 0xe9,
+       0xa5, 0x76, 0x7e, 0x37, 0x9f, 0x6f, 0x03, 0x54,
+       0x82, 0x59, 0x01, 0xbe, 0x0b, 0x5b, 0x49, 0xf0,
+       0x36, 0x1e, 0xf4, 0xa7, 0xc4, 0x29, 0x76, 0x57},
+      {0x88, 0xa8, 0xc6, 0x09, 0x45, 0x02, 0x20, 0x32,
+       0x73, 0x89, 0x55, 0x4b, 0x13, 0x36, 0xe0, 0xd2,
+       0x9f, 0x28, 0x33, 0x3c, 0x23, 0x36, 0xe2, 0x83,
+       0x8f, 0xc1, 0xae, 0x0c, 0xbb, 0x25, 0x1f, 0x70}
+    },
+    {
+      {0x13, 0xc1, 0xbe, 0x7c, 0xd9, 0xf6, 0x18, 0x9d,
+       0xe4, 0xdb, 0xbf, 0x74, 0xe6, 0x06, 0x4a, 0x84,
+       0xd6, 0x60, 0x4e, 0xac, 0x22, 0xb5, 0xf5, 0x20,
+       0x51, 0x5e, 0x95, 0x50, 0xc0, 0x5b, 0x0a, 0x72},
+      {0xed, 0x6c, 0x61, 0xe4, 0xf8, 0xb0, 0xa8, 0xc3,
+       0x7d, 0xa8, 0x25, 0x9e, 0x0e, 0x66, 0x00, 0xf7,
+       0x9c, 0xa5, 0xbc, 0xf4, 0x1f, 0x06, 0xe3, 0x61,
+       0xe9, 0x0b, 0xc4, 0xbd, 0xbf, 0x92, 0x0c, 0x2e},
+      {0x35, 0x5a, 0x80, 0x9b, 0x43, 0x09, 0x3f, 0x0c,
+       0xfc, 0xab, 0x42, 0x62, 0x37, 0x8b, 0x4e, 0xe8,
+       0x46, 0x93, 0x22, 0x5c, 0xf3, 0x17, 0x14, 0x69,
+       0xec, 0xf0, 0x4e, 0x14, 0xbb, 0x9c, 0x9b, 0x0e}
+    },
+    {
+      {0xee, 0xbe, 0xb1, 0x5d, 0xd5, 0x9b, 0xee, 0x8d,
+       0xb9, 0x3f, 0x72, 0x0a, 0x37, 0xab, 0xc3, 0xc9,
+       0x91, 0xd7, 0x68, 0x1c, 0xbf, 0xf1, 0xa8, 0x44,
+       0xde, 0x3c, 0xfd, 0x1c, 0x19, 0x44, 0x6d, 0x36},
+      {0xad, 0x20, 0x57, 0xfb, 0x8f, 0xd4, 0xba, 0xfb,
+       0x0e, 0x0d, 0xf9, 0xdb, 0x6b, 0x91, 0x81, 0xee,
+       0xbf, 0x43, 0x55, 0x63, 0x52, 0x31, 0x81, 0xd4,
+       0xd8, 0x7b, 0x33, 0x3f, 0xeb, 0x04, 0x11, 0x22},
+      {0x14, 0x8c, 0xbc, 0xf2, 0x43, 0x17, 0x3c, 0x9e,
+       0x3b, 0x6c, 0x85, 0xb5, 0xfc, 0x26, 0xda, 0x2e,
+       0x97, 0xfb, 0xa7, 0x68, 0x0e, 0x2f, 0xb8, 0xcc,
+       0x44, 0x32, 0x59, 0xbc, 0xe6, 0xa4, 0x67, 0x41}
+    },
+    {
+      {0xee, 0x8f, 0xce, 0xf8, 0x65, 0x26, 0xbe, 0xc2,
+       0x2c, 0xd6, 0x80, 0xe8, 0x14, 0xff, 0x67, 0xe9,
+       0xee, 0x4e, 0x36, 0x2f, 0x7e, 0x6e, 0x2e, 0xf1,
+       0xf6, 0xd2, 0x7e, 0xcb, 0x70, 0x33, 0xb3, 0x34},
+      {0x00, 0x27, 0xf6, 0x76, 0x28, 0x9d, 0x3b, 0x64,
+       0xeb, 0x68, 0x76, 0x0e, 0x40, 0x9d, 0x1d, 0x5d,
+       0x84, 0x06, 0xfc, 0x21, 0x03, 0x43, 0x4b, 0x1b,
+       0x6a, 0x24, 0x55, 0x22, 0x7e, 0xbb, 0x38, 0x79},
+      {0xcc, 0xd6, 0x81, 0x86, 0xee, 0x91, 0xc5, 0xcd,
+       0x53, 0xa7, 0x85, 0xed, 0x9c, 0x10, 0x02, 0xce,
+       0x83, 0x88, 0x80, 0x58, 0xc1, 0x85, 0x74, 0xed,
+       0xe4, 0x65, 0xfe, 0x2d, 0x6e, 0xfc, 0x76, 0x11}
+    },
+    {
+      {0xb8, 0x0e, 0x77, 0x49, 0x89, 0xe2, 0x90, 0xdb,
+       0xa3, 0x40, 0xf4, 0xac, 0x2a, 0xcc, 0xfb, 0x98,
+       0x9b, 0x87, 0xd7, 0xde, 0xfe, 0x4f, 0x35, 0x21,
+       0xb6, 0x06, 0x69, 0xf2, 0x54, 0x3e, 0x6a, 0x1f},
+      {0x9b, 0x61, 0x9c, 0x5b, 0xd0, 0x6c, 0xaf, 0xb4,
+       0x80, 0x84, 0xa5, 0xb2, 0xf4, 0xc9, 0xdf, 0x2d,
+       0xc4, 0x4d, 0xe9, 0xeb, 0x02, 0xa5, 0x4f, 0x3d,
+       0x34, 0x5f, 0x7d, 0x67, 0x4c, 0x3a, 0xfc, 0x08},
+      {0xea, 0x34, 0x07, 0xd3, 0x99, 0xc1, 0xa4, 0x60,
+       0xd6, 0x5c, 0x16, 0x31, 0xb6, 0x85, 0xc0, 0x40,
+       0x95, 0x82, 0x59, 0xf7, 0x23, 0x3e, 0x33, 0xe2,
+       0xd1, 0x00, 0xb9, 0x16, 0x01, 0xad, 0x2f, 0x4f}
+    },
+    {
+      {0x38, 0xb6, 0x3b, 0xb7, 0x1d, 0xd9, 0x2c, 0x96,
+       0x08, 0x9c, 0x12, 0xfc, 0xaa, 0x77, 0x05, 0xe6,
+       0x89, 0x16, 0xb6, 0xf3, 0x39, 0x9b, 0x61, 0x6f,
+       0x81, 0xee, 0x44, 0x29, 0x5f, 0x99, 0x51, 0x34},
+      {0x54, 0x4e, 0xae, 0x94, 0x41, 0xb2, 0xbe, 0x44,
+       0x6c, 0xef, 0x57, 0x18, 0x51, 0x1c, 0x54, 0x5f,
+       0x98, 0x04, 0x8d, 0x36, 0x2d, 0x6b, 0x1e, 0xa6,
+       0xab, 0xf7, 0x2e, 0x97, 0xa4, 0x84, 0x54, 0x44},
+      {0x7c, 0x7d, 0xea, 0x9f, 0xd0, 0xfc, 0x52, 0x91,
+       0xf6, 0x5c, 0x93, 0xb0, 0x94, 0x6c, 0x81, 0x4a,
+       0x40, 0x5c, 0x28, 0x47, 0xaa, 0x9a, 0x8e, 0x25,
+       0xb7, 0x93, 0x28, 0x04, 0xa6, 0x9c, 0xb8, 0x10}
+    }
+  },
+  { /* 16^40 B */
+    {
+      {0x51, 0x2f, 0x5b, 0x30, 0xfb, 0xbf, 0xee, 0x96,
+       0xb8, 0x96, 0x95, 0x88, 0xad, 0x38, 0xf9, 0xd3,
+       0x25, 0xdd, 0xd5, 0x46, 0xc7, 0x2d, 0xf5, 0xf0,
+       0x95, 0x00, 0x3a, 0xbb, 0x90, 0x82, 0x96, 0x57},
+      {0xdc, 0xae, 0x58, 0x8c, 0x4e, 0x97, 0x37, 0x46,
+       0xa4, 0x41, 0xf0, 0xab, 0xfb, 0x22, 0xef, 0xb9,
+       0x8a, 0x71, 0x80, 0xe9, 0x56, 0xd9, 0x85, 0xe1,
+       0xa6, 0xa8, 0x43, 0xb1, 0xfa, 0x78, 0x1b, 0x2f},
+      {0x01, 0xe1, 0x20, 0x0a, 0x43, 0xb8, 0x1a, 0xf7,
+       0x47, 0xec, 0xf0, 0x24, 0x8d, 0x65, 0x93, 0xf3,
+       0xd1, 0xee, 0xe2, 0x6e, 0xa8, 0x09, 0x75, 0xcf,
+       0xe1, 0xa3, 0x2a, 0xdc, 0x35, 0x3e, 0xc4, 0x7d}
+    },
+    {
+      {0x18, 0x97, 0x3e, 0x27, 0x5c, 0x2a, 0x78, 0x5a,
+       0x94, 0xfd, 0x4e, 0x5e, 0x99, 0xc6, 0x76, 0x35,
+       0x3e, 0x7d, 0x23, 0x1f, 0x05, 0xd8, 0x2e, 0x0f,
+       0x99, 0x0a, 0xd5, 0x82, 0x1d, 0xb8, 0x4f, 0x04},
+      {0xc3, 0xd9, 0x7d, 0x88, 0x65, 0x66, 0x96, 0x85,
+       0x55, 0x53, 0xb0, 0x4b, 0x31, 0x9b, 0x0f, 0xc9,
+       0xb1, 0x79, 0x20, 0xef, 0xf8, 0x8d, 0xe0, 0xc6,
+       0x2f, 0xc1, 0x8c, 0x75, 0x16, 0x20, 0xf7, 0x7e},
+      {0xd9, 0xe3, 0x07, 0xa9, 0xc5, 0x18, 0xdf, 0xc1,
+       0x59, 0x63, 0x4c, 0xce, 0x1d, 0x37, 0xb3, 0x57,
+       0x49, 0xbb, 0x01, 0xb2, 0x34, 0x45, 0x70, 0xca,
+       0x2e, 0xdd, 0x30, 0x9c, 0x3f, 0x82, 0x79, 0x7f}
+    },
+    {
+      {0xba, 0x87, 0xf5, 0x68, 0xf0, 0x1f, 0x9c, 0x6a,
+       0xde, 0xc8, 0x50, 0x00, 0x4e, 0x89, 0x27, 0x08,
+       0xe7, 0x5b, 0xed, 0x7d, 0x55, 0x99, 0xbf, 0x3c,
+       0xf0, 0xd6, 0x06, 0x1c, 0x43, 0xb0, 0xa9, 0x64},
+      {0xe8, 0x13, 0xb5, 0xa3, 0x39, 0xd2, 0x34, 0x83,
+       0xd8, 0xa8, 0x1f, 0xb9, 0xd4, 0x70, 0x36, 0xc1,
+       0x33, 0xbd, 0x90, 0xf5, 0x36, 0x41, 0xb5, 0x12,
+       0xb4, 0xd9, 0x84, 0xd7, 0x73, 0x03, 0x4e, 0x0a},
+      {0x19, 0x29, 0x7d, 0x5b, 0xa1, 0xd6, 0xb3, 0x2e,
+       0x35, 0x82, 0x3a, 0xd5, 0xa0, 0xf6, 0xb4, 0xb0,
+       0x47, 0x5d, 0xa4, 0x89, 0x43, 0xce, 0x56, 0x71,
+       0x6c, 0x34, 0x18, 0xce, 0x0a, 0x7d, 0x1a, 0x07}
+    },
+    {
+      {0x31, 0x44, 0xe1, 0x20, 0x52, 0x35, 0x0c, 0xcc,
+       0x41, 0x51, 0xb1, 0x09, 0x07, 0x95, 0x65, 0x0d,
+       0x36, 0x5f, 0x9d, 0x20, 0x1b, 0x62, 0xf5, 0x9a,
+       0xd3, 0x55, 0x77, 0x61, 0xf7, 0xbc, 0x69, 0x7c},
+      {0x0b, 0xba, 0x87, 0xc8, 0xaa, 0x2d, 0x07, 0xd3,
+       0xee, 0x62, 0xa5, 0xbf, 0x05, 0x29, 0x26, 0x01,
+       0x8b, 0x76, 0xef, 0xc0, 0x02, 0x30, 0x54, 0xcf,
+       0x9c, 0x7e, 0xea, 0x46, 0x71, 0xcc, 0x3b, 0x2c},
+      {0x5f, 0x29, 0xe8, 0x04, 0xeb, 0xd7, 0xf0, 0x07,
+       0x7d, 0xf3, 0x50, 0x2f, 0x25, 0x18, 0xdb, 0x10,
+       0xd7, 0x98, 0x17, 0x17, 0xa3, 0xa9, 0x51, 0xe9,
+       0x1d, 0xa5, 0xac, 0x22, 0x73, 0x9a, 0x5a, 0x6f}
+    },
+    {
+      {0xbe, 0x44, 0xd9, 0xa3, 0xeb, 0xd4, 0x29, 0xe7,
+       0x9e, 0xaf, 0x78, 0x80, 0x40, 0x09, 0x9e, 0x8d,
+       0x03, 0x9c, 0x86, 0x47, 0x7a, 0x56, 0x25, 0x45,
+       0x24, 0x3b, 0x8d, 0xee, 0x80, 0x96, 0xab, 0x02},
+      {0xc5, 0xc6, 0x41, 0x2f, 0x0c, 0x00, 0xa1, 0x8b,
+       0x9b, 0xfb, 0xfe, 0x0c, 0xc1, 0x79, 0x9f, 0xc4,
+       0x9f, 0x1c, 0xc5, 0x3c, 0x70, 0x47, 0xfa, 0x4e,
+       0xca, 0xaf, 0x47, 0xe1, 0xa2, 0x21, 0x4e, 0x49},
+      {0x9a, 0x0d, 0xe5, 0xdd, 0x85, 0x8a, 0xa4, 0xef,
+       0x49, 0xa2, 0xb9, 0x0f, 0x4e, 0x22, 0x9a, 0x21,
+       0xd9, 0xf6, 0x1e, 0xd9, 0x1d, 0x1f, 0x09, 0xfa,
+       0x34, 0xbb, 0x46, 0xea, 0xcb, 0x76, 0x5d, 0x6b}
+    },
+    {
+      {0x22, 0x25, 0x78, 0x1e, 0x17, 0x41, 0xf9, 0xe0,
+       0xd3, 0x36, 0x69, 0x03, 0x74, 0xae, 0xe6, 0xf1,
+       0x46, 0xc7, 0xfc, 0xd0, 0xa2, 0x3e, 0x8b, 0x40,
+       0x3e, 0x31, 0xdd, 0x03, 0x9c, 0x86, 0xfb, 0x16},
+      {0x94, 0xd9, 0x0c, 0xec, 0x6c, 0x55, 0x57, 0x88,
+       0xba, 0x1d, 0xd0, 0x5c, 0x6f, 0xdc, 0x72, 0x64,
+       0x77, 0xb4, 0x42, 0x8f, 0x14, 0x69, 0x01, 0xaf,
+       0x54, 0x73, 0x27, 0x85, 0xf6, 0x33, 0xe3, 0x0a},
+      {0x62, 0x09, 0xb6, 0x33, 0x97, 0x19, 0x8e, 0x28,
+       0x33, 0xe1, 0xab, 0xd8, 0xb4, 0x72, 0xfc, 0x24,
+       0x3e, 0xd0, 0x91, 0x09, 0xed, 0xf7, 0x11, 0x48,
+       0x75, 0xd0, 0x70, 0x8f, 0x8b, 0xe3, 0x81, 0x3f}
+    },
+    {
+      {0x24, 0xc8, 0x17, 0x5f, 0x35, 0x7f, 0xdb, 0x0a,
+       0xa4, 0x99, 0x42, 0xd7, 0xc3, 0x23, 0xb9, 0x74,
+       0xf7, 0xea, 0xf8, 0xcb, 0x8b, 0x3e, 0x7c, 0xd5,
+       0x3d, 0xdc, 0xde, 0x4c, 0xd3, 0xe2, 0xd3, 0x0a},
+      {0xfe, 0xaf, 0xd9, 0x7e, 0xcc, 0x0f, 0x91, 0x7f,
+       0x4b, 0x87, 0x65, 0x24, 0xa1, 0xb8, 0x5c, 0x54,
+       0x04, 0x47, 0x0c, 0x4b, 0xd2, 0x7e, 0x39, 0xa8,
+       0x93, 0x09, 0xf5, 0x04, 0xc1, 0x0f, 0x51, 0x50},
+      {0x9d, 0x24, 0x6e, 0x33, 0xc5, 0x0f, 0x0c, 0x6f,
+       0xd9, 0xcf, 0x31, 0xc3, 0x19, 0xde, 0x5e, 0x74,
+       0x1c, 0xfe, 0xee, 0x09, 0x00, 0xfd, 0xd6, 0xf2,
+       0xbe, 0x1e, 0xfa, 0xf0, 0x8b, 0x15, 0x7c, 0x12}
+    },
+    {
+      {0x74, 0xb9, 0x51, 0xae, 0xc4, 0x8f, 0xa2, 0xde,
+       0x96, 0xfe, 0x4d, 0x74, 0xd3, 0x73, 0x99, 0x1d,
+       0xa8, 0x48, 0x38, 0x87, 0x0b, 0x68, 0x40, 0x62,
+       0x95, 0xdf, 0x67, 0xd1, 0x79, 0x24, 0xd8, 0x4e},
+      {0xa2, 0x79, 0x98, 0x2e, 0x42, 0x7c, 0x19, 0xf6,
+       0x47, 0x36, 0xca, 0x52, 0xd4, 0xdd, 0x4a, 0xa4,
+       0xcb, 0xac, 0x4e, 0x4b, 0xc1, 0x3f, 0x41, 0x9b,
+       0x68, 0x4f, 0xef, 0x07, 0x7d, 0xf8, 0x4e, 0x35},
+      {0x75, 0xd9, 0xc5, 0x60, 0x22, 0xb5, 0xe3, 0xfe,
+       0xb8, 0xb0, 0x41, 0xeb, 0xfc, 0x2e, 0x35, 0x50,
+       0x3c, 0x65, 0xf6, 0xa9, 0x30, 0xac, 0x08, 0x88,
+       0x6d, 0x23, 0x39, 0x05, 0xd2, 0x92, 0x2d, 0x30}
+    }
+  },
+  { /* 16^48 B */
+    {
+      {0xc0, 0x1a, 0x0c, 0xc8, 0x9d, 0xcc, 0x6d, 0xa6,
+       0x36, 0xa4, 0x38, 0x1b, 0xf4, 0x5c, 0xa0, 0x97,
+       0xc6, 0xd7, 0xdb, 0x95, 0xbe, 0xf3, 0xeb, 0xa7,
+       0xab, 0x7d, 0x7e, 0x8d, 0xf6, 0xb8, 0xa0, 0x7d},
+      {0xa6, 0x75, 0x56, 0x38, 0x14, 0x20, 0x78, 0xef,
+       0xe8, 0xa9, 0xfd, 0xaa, 0x30, 0x9f, 0x64, 0xa2,
+       0xcb, 0xa8, 0xdf, 0x5c, 0x50, 0xeb, 0xd1, 0x4c,
+       0xb3, 0xc0, 0x4d, 0x1d, 0xba, 0x5a, 0x11, 0x46},
+      {0x76, 0xda, 0xb5, 0xc3, 0x53, 0x19, 0x0f, 0xd4,
+       0x9b, 0x9e, 0x11, 0x21, 0x73, 0x6f, 0xac, 0x1d,
+       0x60, 0x59, 0xb2, 0xfe, 0x21, 0x60, 0xcc, 0x03,
+       0x4b, 0x4b, 0x67, 0x83, 0x7e, 0x88, 0x5f, 0x5a}
+    },
+    {
+      {0xb9, 0x43, 0xa6, 0xa0, 0xd3, 0x28, 0x96, 0x9e,
+       0x64, 0x20, 0xc3, 0xe6, 0x00, 0xcb, 0xc3, 0xb5,
+       0x32, 0xec, 0x2d, 0x7c, 0x89, 0x02, 0x53, 0x9b,
+       0x0c, 0xc7, 0xd1, 0xd5, 0xe2, 0x7a, 0xe3, 0x43},
+      {0x11, 0x3d, 0xa1, 0x70, 0xcf, 0x01, 0x63, 0x8f,
+       0xc4, 0xd0, 0x0d, 0x35, 0x15, 0xb8, 0xce, 0xcf,
+       0x7e, 0xa4, 0xbc, 0xa4, 0xd4, 0x97, 0x02, 0xf7,
+       0x34, 0x14, 0x4d, 0xe4, 0x56, 0xb6, 0x69, 0x36},
+      {0x33, 0xe1, 0xa6, 0xed, 0x06, 0x3f, 0x7e, 0x38,
+       0xc0, 0x3a, 0xa1, 0x99, 0x51, 0x1d, 0x30, 0x67,
+       0x11, 0x38, 0x26, 0x36, 0xf8, 0xd8, 0x5a, 0xbd,
+       0xbe, 0xe9, 0xd5, 0x4f, 0xcd, 0xe6, 0x21, 0x6a}
+    },
+    {
+      {0xe3, 0xb2, 0x99, 0x66, 0x12, 0x29, 0x41, 0xef,
+       0x01, 0x13, 0x8d, 0x70, 0x47, 0x08, 0xd3, 0x71,
+       0xbd, 0xb0, 0x82, 0x11, 0xd0, 0x32, 0x54, 0x32,
+       0x36, 0x8b, 0x1e, 0x00, 0x07, 0x1b, 0x37, 0x45},
+      {0x5f, 0xe6, 0x46, 0x30, 0x0a, 0x17, 0xc6, 0xf1,
+       0x24, 0x35, 0xd2, 0x00, 0x2a, 0x2a, 0x71, 0x58,
+       0x55, 0xb7, 0x82, 0x8c, 0x3c, 0xbd, 0xdb, 0x69,
+       0x57, 0xff, 0x95, 0xa1, 0xf1, 0xf9, 0x6b, 0x58},
+      {0x0b, 0x79, 0xf8, 0x5e, 0x8d, 0x08, 0xdb, 0xa6,
+       0xe5, 0x37, 0x09, 0x61, 0xdc, 0xf0, 0x78, 0x52,
+       0xb8, 0x6e, 0xa1, 0x61, 0xd2, 0x49, 0x03, 0xac,
+       0x79, 0x21, 0xe5, 0x90, 0x37, 0xb0, 0xaf, 0x0e}
+    },
+    {
+      {0x1d, 0xae, 0x75, 0x0f, 0x5e, 0x80, 0x40, 0x51,
+       0x30, 0xcc, 0x62, 0x26, 0xe3, 0xfb, 0x02, 0xec,
+       0x6d, 0x39, 0x92, 0xea, 0x1e, 0xdf, 0xeb, 0x2c,
+       0xb3, 0x5b, 0x43, 0xc5, 0x44, 0x33, 0xae, 0x44},
+      {0x2f, 0x04, 0x48, 0x37, 0xc1, 0x55, 0x05, 0x96,
+       0x11, 0xaa, 0x0b, 0x82, 0xe6, 0x41, 0x9a, 0x21,
+       0x0c, 0x6d, 0x48, 0x73, 0x38, 0xf7, 0x81, 0x1c,
+       0x61, 0xc6, 0x02, 0x5a, 0x67, 0xcc, 0x9a, 0x30},
+      {0xee, 0x43, 0xa5, 0xbb, 0xb9, 0x89, 0xf2, 0x9c,
+       0x42, 0x71, 0xc9, 0x5a, 0x9d, 0x0e, 0x76, 0xf3,
+       0xaa, 0x60, 0x93, 0x4f, 0xc6, 0xe5, 0x82, 0x1d,
+       0x8f, 0x67, 0x94, 0x7f, 0x1b, 0x22, 0xd5, 0x62}
+    },
+    {
+      {0x3c, 0x7a, 0xf7, 0x3a, 0x26, 0xd4, 0x85, 0x75,
+       0x4d, 0x14, 0xe9, 0xfe, 0x11, 0x7b, 0xae, 0xdf,
+       0x3d, 0x19, 0xf7, 0x59, 0x80, 0x70, 0x06, 0xa5,
+       0x37, 0x20, 0x92, 0x83, 0x53, 0x9a, 0xf2, 0x14},
+      {0x6d, 0x93, 0xd0, 0x18, 0x9c, 0x29, 0x4c, 0x52,
+       0x0c, 0x1a, 0x0c, 0x8a, 0x6c, 0xb5, 0x6b, 0xc8,
+       0x31, 0x86, 0x4a, 0xdb, 0x2e, 0x05, 0x75, 0xa3,
+       0x62, 0x45, 0x75, 0xbc, 0xe4, 0xfd, 0x0e, 0x5c},
+      {0xf5, 0xd7, 0xb2, 0x25, 0xdc, 0x7e, 0x71, 0xdf,
+       0x40, 0x30, 0xb5, 0x99, 0xdb, 0x70, 0xf9, 0x21,
+       0x62, 0x4c, 0xed, 0xc3, 0xb7, 0x34, 0x92, 0xda,
+       0x3e, 0x09, 0xee, 0x7b, 0x5c, 0x36, 0x72, 0x5e}
+    },
+    {
+      {0x3e, 0xb3, 0x08, 0x2f, 0x06, 0x39, 0x93, 0x7d,
+       0xbe, 0x32, 0x9f, 0xdf, 0xe5, 0x59, 0x96, 0x5b,
+       0xfd, 0xbd, 0x9e, 0x1f, 0xad, 0x3d, 0xff, 0xac,
+       0xb7, 0x49, 0x73, 0xcb, 0x55, 0x05, 0xb2, 0x70},
+      {0x7f, 0x21, 0x71, 0x45, 0x07, 0xfc, 0x5b, 0x57,
+       0x5b, 0xd9, 0x94, 0x06, 0x5d, 0x67, 0x79, 0x37,
+       0x33, 0x1e, 0x19, 0xf4, 0xbb, 0x37, 0x0a, 0x9a,
+       0xbc, 0xea, 0xb4, 0x47, 0x4c, 0x10, 0xf1, 0x77},
+      {0x4c, 0x2c, 0x11, 0x55, 0xc5, 0x13, 0x51, 0xbe,
+       0xcd, 0x1f, 0x88, 0x9a, 0x3a, 0x42, 0x88, 0x66,
+       0x47, 0x3b, 0x50, 0x5e, 0x85, 0x77, 0x66, 0x44,
+       0x4a, 0x40, 0x06, 0x4a, 0x8f, 0x39, 0x34, 0x0e}
+    },
+    {
+      {0x28, 0x19, 0x4b, 0x3e, 0x09, 0x0b, 0x93, 0x18,
+       0x40, 0xf6, 0xf3, 0x73, 0x0e, 0xe1, 0xe3, 0x7d,
+       0x6f, 0x5d, 0x39, 0x73, 0xda, 0x17, 0x32, 0xf4,
+       0x3e, 0x9c, 0x37, 0xca, 0xd6, 0xde, 0x8a, 0x6f},
+      {0xe8, 0xbd, 0xce, 0x3e, 0xd9, 0x22, 0x7d, 0xb6,
+       0x07, 0x2f, 0x82, 0x27, 0x41, 0xe8, 0xb3, 0x09,
+       0x8d, 0x6d, 0x5b, 0xb0, 0x1f, 0xa6, 0x3f, 0x74,
+       0x72, 0x23, 0x36, 0x8a, 0x36, 0x05, 0x54, 0x5e},
+      {0x9a, 0xb2, 0xb7, 0xfd, 0x3d, 0x12, 0x40, 0xe3,
+       0x91, 0xb2, 0x1a, 0xa2, 0xe1, 0x97, 0x7b, 0x48,
+       0x9e, 0x94, 0xe6, 0xfd, 0x02, 0x7d, 0x96, 0xf9,
+       0x97, 0xde, 0xd3, 0xc8, 0x2e, 0xe7, 0x0d, 0x78}
+    },
+    {
+      {0x72, 0x27, 0xf4, 0x00, 0xf3, 0xea, 0x1f, 0x67,
+       0xaa, 0x41, 0x8c, 0x2a, 0x2a, 0xeb, 0x72, 0x8f,
+       0x92, 0x32, 0x37, 0x97, 0xd7, 0x7f, 0xa1, 0x29,
+       0xa6, 0x87, 0xb5, 0x32, 0xad, 0xc6, 0xef, 0x1d},
+      {0xbc, 0xe7, 0x9a, 0x08, 0x45, 0x85, 0xe2, 0x0a,
+       0x06, 0x4d, 0x7f, 0x1c, 0xcf, 0xde, 0x8d, 0x38,
+       0xb8, 0x11, 0x48, 0x0a, 0x51, 0x15, 0xac, 0x38,
+       0xe4, 0x8c, 0x92, 0x71, 0xf6, 0x8b, 0xb2, 0x0e},
+      {0xa7, 0x95, 0x51, 0xef, 0x1a, 0xbe, 0x5b, 0xaf,
+       0xed, 0x15, 0x7b, 0x91, 0x77, 0x12, 0x8c, 0x14,
+       0x2e, 0xda, 0xe5, 0x7a, 0xfb, 0xf7, 0x91, 0x29,
+       0x67, 0x28, 0xdd, 0xf8, 0x1b, 0x20, 0x7d, 0x46}
+    }
+  },
+  { /* 16^56 B */
+    {
+      {0x7f, 0x87, 0x3b, 0x19, 0xc9, 0x00, 0x2e, 0xbb,
+       0x6b, 0x50, 0xdc, 0xe0, 0x90, 0xa8, 0xe3, 0xec,
+       0x9f, 0x64, 0xde, 0x36, 0xc0, 0xb7, 0xf3, 0xec,
+       0x1a, 0x9e, 0xde, 0x98, 0x08, 0x04, 0x46, 0x5f},
+      {0xdb, 0xce, 0x2f, 0x83, 0x45, 0x88, 0x9d, 0x73,
+       0x63, 0xf8, 0x6b, 0xae, 0xc9, 0xd6, 0x38, 0xfa,
+       0xf7, 0xfe, 0x4f, 0xb7, 0xca, 0x0d, 0xbc, 0x32,
+       0x5e, 0xe4, 0xbc, 0x14, 0x88, 0x7e, 0x93, 0x73},
+      {0x8d, 0xf4, 0x7b, 0x29, 0x16, 0x71, 0x03, 0xb9,
+       0x34, 0x68, 0xf0, 0xd4, 0x22, 0x3b, 0xd1, 0xa9,
+       0xc6, 0xbd, 0x96, 0x46, 0x57, 0x15, 0x97, 0xe1,
+       0x35, 0xe8, 0xd5, 0x91, 0xe8, 0xa4, 0xf8, 0x2c}
+    },
+    {
+      {0xa2, 0x6b, 0xd0, 0x17, 0x7e, 0x48, 0xb5, 0x2c,
+       0x6b, 0x19, 0x50, 0x39, 0x1c, 0x38, 0xd2, 0x24,
+       0x30, 0x8a, 0x97, 0x85, 0x81, 0x9c, 0x65, 0xd7,
+       0xf6, 0xa4, 0xd6, 0x91, 0x28, 0x7f, 0x6f, 0x7a},
+      {0x67, 0x0f, 0x11, 0x07, 0x87, 0xfd, 0x93, 0x6d,
+       0x49, 0xb5, 0x38, 0x7c, 0xd3, 0x09, 0x4c, 0xdd,
+       0x86, 0x6a, 0x73, 0xc2, 0x4c, 0x6a, 0xb1, 0x7c,
+       0x09, 0x2a, 0x25, 0x58, 0x6e, 0xbd, 0x49, 0x20},
+      {0x49, 0xef, 0x9a, 0x6a, 0x8d, 0xfd, 0x09, 0x7d,
+       0x0b, 0xb9, 0x3d, 0x5b, 0xbe, 0x60, 0xee, 0xf0,
+       0xd4, 0xbf, 0x9e, 0x51, 0x2c, 0xb5, 0x21, 0x4c,
+       0x1d, 0x94, 0x45, 0xc5, 0xdf, 0xaa, 0x11, 0x60}
+    },
+    {
+      {0x90, 0xf8, 0xcb, 0x02, 0xc8, 0xd0, 0xde, 0x63,
+       0xaa, 0x6a, 0xff, 0x0d, 0xca, 0x98, 0xd0, 0xfb,
+       0x99, 0xed, 0xb6, 0xb9, 0xfd, 0x0a, 0x4d, 0x62,
+       0x1e, 0x0b, 0x34, 0x79, 0xb7, 0x18, 0xce, 0x69},
+      {0x3c, 0xf8, 0x95, 0xcf, 0x6d, 0x92, 0x67, 0x5f,
+       0x71, 0x90, 0x28, 0x71, 0x61, 0x85, 0x7e, 0x7c,
+       0x5b, 0x7a, 0x8f, 0x99, 0xf3, 0xe7, 0xa1, 0xd6,
+       0xe0, 0xf9, 0x62, 0x0b, 0x1b, 0xcc, 0xc5, 0x6f},
+      {0xcb, 0x79, 0x98, 0xb2, 0x28, 0x55, 0xef, 0xd1,
+       0x92, 0x90, 0x7e, 0xd4, 0x3c, 0xae, 0x1a, 0xdd,
+       0x52, 0x23, 0x9f, 0x18, 0x42, 0x04, 0x7e, 0x12,
+       0xf1, 0x01, 0x71, 0xe5, 0x3a, 0x6b, 0x59, 0x15}
+    },
+    {
+      {0xca, 0x24, 0x51, 0x7e, 0x16, 0x31, 0xff, 0x09,
+       0xdf, 0x45, 0xc7, 0xd9, 0x8b, 0x15, 0xe4, 0x0b,
+       0xe5, 0x56, 0xf5, 0x7e, 0x22, 0x7d, 0x2b, 0x29,
+       0x38, 0xd1, 0xb6, 0xaf, 0x41, 0xe2, 0xa4, 0x3a},
+      {0xa2, 0x79, 0x91, 0x3f, 0xd2, 0x39, 0x27, 0x46,
+       0xcf, 0xdd, 0xd6, 0x97, 0x31, 0x12, 0x83, 0xff,
+       0x8a, 0x14, 0xf2, 0x53, 0xb5, 0xde, 0x07, 0x13,
+       0xda, 0x4d, 0x5f, 0x7b, 0x68, 0x37, 0x22, 0x0d},
+      {0xf5, 0x05, 0x33, 0x2a, 0xbf, 0x38, 0xc1, 0x2c,
+       0xc3, 0x26, 0xe9, 0xa2, 0x8f, 0x3f, 0x58, 0x48,
+       0xeb, 0xd2, 0x49, 0x55, 0xa2, 0xb1, 0x3a, 0x08,
+       0x6c, 0xa3, 0x87, 0x46, 0x6e, 0xaa, 0xfc, 0x32}
+    },
+    {
+      {0xdf, 0xcc, 0x87, 0x27, 0x73, 0xa4, 0x07, 0x32,
+       0xf8, 0xe3, 0x13, 0xf2, 0x08, 0x19, 0xe3, 0x17,
+       0x4e, 0x96, 0x0d, 0xf6, 0xd7, 0xec, 0xb2, 0xd5,
+       0xe9, 0x0b, 0x60, 0xc2, 0x36, 0x63, 0x6f, 0x74},
+      {0xf5, 0x9a, 0x7d, 0xc5, 0x8d, 0x6e, 0xc5, 0x7b,
+       0xf2, 0xbd, 0xf0, 0x9d, 0xed, 0xd2, 0x0b, 0x3e,
+       0xa3, 0xe4, 0xef, 0x22, 0xde, 0x14, 0xc0, 0xaa,
+       0x5c, 0x6a, 0xbd, 0xfe, 0xce, 0xe9, 0x27, 0x46},
+      {0x1c, 0x97, 0x6c, 0xab, 0x45, 0xf3, 0x4a, 0x3f,
+       0x1f, 0x73, 0x43, 0x99, 0x72, 0xeb, 0x88, 0xe2,
+       0x6d, 0x18, 0x44, 0x03, 0x8a, 0x6a, 0x59, 0x33,
+       0x93, 0x62, 0xd6, 0x7e, 0x00, 0x17, 0x49, 0x7b}
+    },
+    {
+      {0xdd, 0xa2, 0x53, 0xdd, 0x28, 0x1b, 0x34, 0x54,
+       0x3f, 0xfc, 0x42, 0xdf, 0x5b, 0x90, 0x17, 0xaa,
+       0xf4, 0xf8, 0xd2, 0x4d, 0xd9, 0x92, 0xf5, 0x0f,
+       0x7d, 0xd3, 0x8c, 0xe0, 0x0f, 0x62, 0x03, 0x1d},
+      {0x64, 0xb0, 0x84, 0xab, 0x5c, 0xfb, 0x85, 0x2d,
+       0x14, 0xbc, 0xf3, 0x89, 0xd2, 0x10, 0x78, 0x49,
+       0x0c, 0xce, 0x15, 0x7b, 0x44, 0xdc, 0x6a, 0x47,
+       0x7b, 0xfd, 0x44, 0xf8, 0x76, 0xa3, 0x2b, 0x12},
+      {0x54, 0xe5, 0xb4, 0xa2, 0xcd, 0x32, 0x02, 0xc2,
+       0x7f, 0x18, 0x5d, 0x11, 0x42, 0xfd, 0xd0, 0x9e,
+       0xd9, 0x79, 0xd4, 0x7d, 0xbe, 0xb4, 0xab, 0x2e,
+       0x4c, 0xec, 0x68, 0x2b, 0xf5, 0x0b, 0xc7, 0x02}
+    },
+    {
+      {0xe1, 0x72, 0x8d, 0x45, 0xbf, 0x32, 0xe5, 0xac,
+       0xb5, 0x3c, 0xb7, 0x7c, 0xe0, 0x68, 0xe7, 0x5b,
+       0xe7, 0xbd, 0x8b, 0xee, 0x94, 0x7d, 0xcf, 0x56,
+       0x03, 0x3a, 0xb4, 0xfe, 0xe3, 0x97, 0x06, 0x6b},
+      {0xbb, 0x2f, 0x0b, 0x5d, 0x4b, 0xec, 0x87, 0xa2,
+       0xca, 0x82, 0x48, 0x07, 0x90, 0x57, 0x5c, 0x41,
+       0x5c, 0x81, 0xd0, 0xc1, 0x1e, 0xa6, 0x44, 0xe0,
+       0xe0, 0xf5, 0x9e, 0x40, 0x0a, 0x4f, 0x33, 0x26},
+      {0xc0, 0xa3, 0x62, 0xdf, 0x4a, 0xf0, 0xc8, 0xb6,
+       0x5d, 0xa4, 0x6d, 0x07, 0xef, 0x00, 0xf0, 0x3e,
+       0xa9, 0xd2, 0xf0, 0x49, 0x58, 0xb9, 0x9c, 0x9c,
+       0xae, 0x2f, 0x1b, 0x44, 0x43, 0x7f, 0xc3, 0x1c}
+    },
+    {
+      {0xb9, 0xae, 0xce, 0xc9, 0xf1, 0x56, 0x66, 0xd7,
+       0x6a, 0x65, 0xe5, 0x18, 0xf8, 0x15, 0x5b, 0x1c,
+       0x34, 0x23, 0x4c, 0x84, 0x32, 0x28, 0xe7, 0x26,
+       0x38, 0x68, 0x19, 0x2f, 0x77, 0x6f, 0x34, 0x3a},
+      {0x4f, 0x32, 0xc7, 0x5c, 0x5a, 0x56, 0x8f, 0x50,
+       0x22, 0xa9, 0x06, 0xe5, 0xc0, 0xc4, 0x61, 0xd0,
+       0x19, 0xac, 0x45, 0x5c, 0xdb, 0xab, 0x18, 0xfb,
+       0x4a, 0x31, 0x80, 0x03, 0xc1, 0x09, 0x68, 0x6c},
+      {0xc8, 0x6a, 0xda, 0xe2, 0x12, 0x51, 0xd5, 0xd2,
+       0xed, 0x51, 0xe8, 0xb1, 0x31, 0x03, 0xbd, 0xe9,
+       0x62, 0x72, 0xc6, 0x8e, 0xdd, 0x46, 0x07, 0x96,
+       0xd0, 0xc5, 0xf7, 0x6e, 0x9f, 0x1b, 0x91, 0x05}
+    }
+  }
+};
+
+#endif /* CURVE25519_BASE_H */
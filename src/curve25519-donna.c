@@ -46,7 +46,7 @@
  * from the sample implementation. */
 
 #include <string.h>
-#include "../config.h"
+#include "curve25519-donna.h"
 
 /* Field element representation:
  *
@@ -856,8 +856,8 @@ crecip(int64_t *out, const int64_t *z)
   /* 2^255 - 21 */ fmul(out,t1,z11);
 }
 
-int
-curve25519_donna(
+static int
+curve25519_ref(
         uint8_t *mypublic,
         const uint8_t *secret,
         const uint8_t *basepoint)
@@ -878,3 +878,1040 @@ curve25519_donna(
   fcontract(mypublic, z);
   return 0;
 }
+
+#ifdef __SIZEOF_INT128__
+/* 64-bit backend, after curve25519-donna-c64:
+ *
+ * Field elements are five unsigned 51-bit limbs, least significant
+ * first, and products are accumulated in 128-bit integers. On 64-bit
+ * machines this needs a fraction of the multiplies of the code above,
+ * while producing identical results. */
+#define CURVE25519_C64
+
+#include "curve25519-base.h"
+
+__extension__ typedef unsigned __int128 uint128_t;
+typedef uint64_t limb;
+typedef limb felem[5];
+
+#define MASK51 ((((limb)1) << 51) - 1)
+
+/* Sum two numbers: output += in */
+static void
+c64_fsum(limb *output, const limb *in)
+{
+  output[0] += in[0];
+  output[1] += in[1];
+  output[2] += in[2];
+  output[3] += in[3];
+  output[4] += in[4];
+}
+
+/* Find the difference of two numbers: output = in - output
+ * (note the order of the arguments!)
+ *
+ * Assumes that out[i] < 2**52
+ * On return, out[i] < 2**55 */
+static void
+c64_fdifference_backwards(felem out, const felem in)
+{
+  /* 152 is 19 << 3 */
+  static const limb two54m152 = (((limb)1) << 54) - 152;
+  static const limb two54m8 = (((limb)1) << 54) - 8;
+
+  out[0] = in[0] + two54m152 - out[0];
+  out[1] = in[1] + two54m8 - out[1];
+  out[2] = in[2] + two54m8 - out[2];
+  out[3] = in[3] + two54m8 - out[3];
+  out[4] = in[4] + two54m8 - out[4];
+}
+
+/* Multiply a number by a scalar: output = in * scalar */
+static void
+c64_fscalar_product(felem output, const felem in, const limb scalar)
+{
+  uint128_t a;
+
+  a = in[0] * (uint128_t)scalar;
+  output[0] = ((limb)a) & MASK51;
+
+  a = in[1] * (uint128_t)scalar + ((limb)(a >> 51));
+  output[1] = ((limb)a) & MASK51;
+
+  a = in[2] * (uint128_t)scalar + ((limb)(a >> 51));
+  output[2] = ((limb)a) & MASK51;
+
+  a = in[3] * (uint128_t)scalar + ((limb)(a >> 51));
+  output[3] = ((limb)a) & MASK51;
+
+  a = in[4] * (uint128_t)scalar + ((limb)(a >> 51));
+  output[4] = ((limb)a) & MASK51;
+
+  output[0] += (a >> 51) * 19;
+}
+
+/* Multiply two numbers: output = in2 * in
+ *
+ * The inputs are reduced coefficient form, the output is not. Since
+ * the inputs are read before output is written, they may alias it.
+ *
+ * Assumes that in[i] < 2**55 and likewise for in2.
+ * On return, output[i] < 2**52 */
+static void
+c64_fmul(felem output, const felem in2, const felem in)
+{
+  uint128_t t[5];
+  limb r0, r1, r2, r3, r4, s0, s1, s2, s3, s4, c;
+
+  r0 = in[0];
+  r1 = in[1];
+  r2 = in[2];
+  r3 = in[3];
+  r4 = in[4];
+
+  s0 = in2[0];
+  s1 = in2[1];
+  s2 = in2[2];
+  s3 = in2[3];
+  s4 = in2[4];
+
+  t[0] = ((uint128_t)r0) * s0;
+  t[1] = ((uint128_t)r0) * s1 + ((uint128_t)r1) * s0;
+  t[2] = ((uint128_t)r0) * s2 + ((uint128_t)r2) * s0 +
+         ((uint128_t)r1) * s1;
+  t[3] = ((uint128_t)r0) * s3 + ((uint128_t)r3) * s0 +
+         ((uint128_t)r1) * s2 + ((uint128_t)r2) * s1;
+  t[4] = ((uint128_t)r0) * s4 + ((uint128_t)r4) * s0 +
+         ((uint128_t)r3) * s1 + ((uint128_t)r1) * s3 +
+         ((uint128_t)r2) * s2;
+
+  r4 *= 19;
+  r1 *= 19;
+  r2 *= 19;
+  r3 *= 19;
+
+  t[0] += ((uint128_t)r4) * s1 + ((uint128_t)r1) * s4 +
+          ((uint128_t)r2) * s3 + ((uint128_t)r3) * s2;
+  t[1] += ((uint128_t)r4) * s2 + ((uint128_t)r2) * s4 +
+          ((uint128_t)r3) * s3;
+  t[2] += ((uint128_t)r4) * s3 + ((uint128_t)r3) * s4;
+  t[3] += ((uint128_t)r4) * s4;
+
+               r0 = (limb)t[0] & MASK51; c = (limb)(t[0] >> 51);
+  t[1] += c;   r1 = (limb)t[1] & MASK51; c = (limb)(t[1] >> 51);
+  t[2] += c;   r2 = (limb)t[2] & MASK51; c = (limb)(t[2] >> 51);
+  t[3] += c;   r3 = (limb)t[3] & MASK51; c = (limb)(t[3] >> 51);
+  t[4] += c;   r4 = (limb)t[4] & MASK51; c = (limb)(t[4] >> 51);
+  r0 += c * 19; c = r0 >> 51; r0 = r0 & MASK51;
+  r1 += c;      c = r1 >> 51; r1 = r1 & MASK51;
+  r2 += c;
+
+  output[0] = r0;
+  output[1] = r1;
+  output[2] = r2;
+  output[3] = r3;
+  output[4] = r4;
+}
+
+/* Square a number COUNT times: output = in^(2^count)
+ *
+ * Same bounds as c64_fmul(), and likewise in may alias output. */
+static void
+c64_fsquare_times(felem output, const felem in, limb count)
+{
+  uint128_t t[5];
+  limb r0, r1, r2, r3, r4, c;
+  limb d0, d1, d2, d4, d419;
+
+  r0 = in[0];
+  r1 = in[1];
+  r2 = in[2];
+  r3 = in[3];
+  r4 = in[4];
+
+  do {
+    d0 = r0 * 2;
+    d1 = r1 * 2;
+    d2 = r2 * 2 * 19;
+    d419 = r4 * 19;
+    d4 = d419 * 2;
+
+    t[0] = ((uint128_t)r0) * r0 + ((uint128_t)d4) * r1 +
+           ((uint128_t)d2) * r3;
+    t[1] = ((uint128_t)d0) * r1 + ((uint128_t)d4) * r2 +
+           ((uint128_t)r3) * (r3 * 19);
+    t[2] = ((uint128_t)d0) * r2 + ((uint128_t)r1) * r1 +
+           ((uint128_t)d4) * r3;
+    t[3] = ((uint128_t)d0) * r3 + ((uint128_t)d1) * r2 +
+           ((uint128_t)r4) * d419;
+    t[4] = ((uint128_t)d0) * r4 + ((uint128_t)d1) * r3 +
+           ((uint128_t)r2) * r2;
+
+                 r0 = (limb)t[0] & MASK51; c = (limb)(t[0] >> 51);
+    t[1] += c;   r1 = (limb)t[1] & MASK51; c = (limb)(t[1] >> 51);
+    t[2] += c;   r2 = (limb)t[2] & MASK51; c = (limb)(t[2] >> 51);
+    t[3] += c;   r3 = (limb)t[3] & MASK51; c = (limb)(t[3] >> 51);
+    t[4] += c;   r4 = (limb)t[4] & MASK51; c = (limb)(t[4] >> 51);
+    r0 += c * 19; c = r0 >> 51; r0 = r0 & MASK51;
+    r1 += c;      c = r1 >> 51; r1 = r1 & MASK51;
+    r2 += c;
+  } while (--count);
+
+  output[0] = r0;
+  output[1] = r1;
+  output[2] = r2;
+  output[3] = r3;
+  output[4] = r4;
+}
+
+/* Load a little-endian 64-bit number */
+static limb
+c64_load_limb(const uint8_t *in)
+{
+  return ((limb)in[0]) |
+         (((limb)in[1]) << 8) |
+         (((limb)in[2]) << 16) |
+         (((limb)in[3]) << 24) |
+         (((limb)in[4]) << 32) |
+         (((limb)in[5]) << 40) |
+         (((limb)in[6]) << 48) |
+         (((limb)in[7]) << 56);
+}
+
+/* Store a little-endian 64-bit number */
+static void
+c64_store_limb(uint8_t *out, limb in)
+{
+  out[0] = in & 0xff;
+  out[1] = (in >> 8) & 0xff;
+  out[2] = (in >> 16) & 0xff;
+  out[3] = (in >> 24) & 0xff;
+  out[4] = (in >> 32) & 0xff;
+  out[5] = (in >> 40) & 0xff;
+  out[6] = (in >> 48) & 0xff;
+  out[7] = (in >> 56) & 0xff;
+}
+
+/* Take a little-endian, 32-byte number and expand it into polynomial
+ * form, ignoring the top bit like fexpand(). */
+static void
+c64_fexpand(limb *output, const uint8_t *in)
+{
+  output[0] = c64_load_limb(in) & MASK51;
+  output[1] = (c64_load_limb(in + 6) >> 3) & MASK51;
+  output[2] = (c64_load_limb(in + 12) >> 6) & MASK51;
+  output[3] = (c64_load_limb(in + 19) >> 1) & MASK51;
+  output[4] = (c64_load_limb(in + 24) >> 12) & MASK51;
+}
+
+/* Take a fully reduced polynomial form number and contract it into a
+ * little-endian, 32-byte array */
+static void
+c64_fcontract(uint8_t *output, const felem input)
+{
+  uint128_t t[5];
+
+  t[0] = input[0];
+  t[1] = input[1];
+  t[2] = input[2];
+  t[3] = input[3];
+  t[4] = input[4];
+
+  t[1] += t[0] >> 51; t[0] &= MASK51;
+  t[2] += t[1] >> 51; t[1] &= MASK51;
+  t[3] += t[2] >> 51; t[2] &= MASK51;
+  t[4] += t[3] >> 51; t[3] &= MASK51;
+  t[0] += 19 * (t[4] >> 51); t[4] &= MASK51;
+
+  t[1] += t[0] >> 51; t[0] &= MASK51;
+  t[2] += t[1] >> 51; t[1] &= MASK51;
+  t[3] += t[2] >> 51; t[2] &= MASK51;
+  t[4] += t[3] >> 51; t[3] &= MASK51;
+  t[0] += 19 * (t[4] >> 51); t[4] &= MASK51;
+
+  /* now t is between 0 and 2^255-1, properly carried. */
+  /* case 1: between 0 and 2^255-20. case 2: between 2^255-19 and
+   * 2^255-1. */
+
+  t[0] += 19;
+
+  t[1] += t[0] >> 51; t[0] &= MASK51;
+  t[2] += t[1] >> 51; t[1] &= MASK51;
+  t[3] += t[2] >> 51; t[2] &= MASK51;
+  t[4] += t[3] >> 51; t[3] &= MASK51;
+  t[0] += 19 * (t[4] >> 51); t[4] &= MASK51;
+
+  /* now between 19 and 2^255-1 in both cases, and offset by 19. */
+
+  t[0] += (MASK51 + 1) - 19;
+  t[1] += (MASK51 + 1) - 1;
+  t[2] += (MASK51 + 1) - 1;
+  t[3] += (MASK51 + 1) - 1;
+  t[4] += (MASK51 + 1) - 1;
+
+  /* now between 2^255 and 2^256-20, and offset by 2^255. */
+
+  t[1] += t[0] >> 51; t[0] &= MASK51;
+  t[2] += t[1] >> 51; t[1] &= MASK51;
+  t[3] += t[2] >> 51; t[2] &= MASK51;
+  t[4] += t[3] >> 51; t[3] &= MASK51;
+  t[4] &= MASK51;
+
+  c64_store_limb(output, t[0] | (t[1] << 51));
+  c64_store_limb(output + 8, (t[1] >> 13) | (t[2] << 38));
+  c64_store_limb(output + 16, (t[2] >> 26) | (t[3] << 25));
+  c64_store_limb(output + 24, (t[3] >> 39) | (t[4] << 12));
+}
+
+/* Input: Q, Q', Q-Q'
+ * Output: 2Q, Q+Q'
+ *
+ * See fmonty() above. */
+static void
+c64_fmonty(limb *x2, limb *z2,  /* output 2Q */
+           limb *x3, limb *z3,  /* output Q + Q' */
+           limb *x, limb *z,    /* input Q */
+           limb *xprime, limb *zprime,  /* input Q' */
+           const limb *qmqp /* input Q - Q' */)
+{
+  limb origx[5], origxprime[5], zzz[5], xx[5], zz[5], xxprime[5],
+        zzprime[5], zzzprime[5];
+
+  memcpy(origx, x, 5 * sizeof(limb));
+  c64_fsum(x, z);
+  c64_fdifference_backwards(z, origx);  /* does x - z */
+
+  memcpy(origxprime, xprime, sizeof(limb) * 5);
+  c64_fsum(xprime, zprime);
+  c64_fdifference_backwards(zprime, origxprime);
+  c64_fmul(xxprime, xprime, z);
+  c64_fmul(zzprime, x, zprime);
+  memcpy(origxprime, xxprime, sizeof(limb) * 5);
+  c64_fsum(xxprime, zzprime);
+  c64_fdifference_backwards(zzprime, origxprime);
+  c64_fsquare_times(x3, xxprime, 1);
+  c64_fsquare_times(zzzprime, zzprime, 1);
+  c64_fmul(z3, zzzprime, qmqp);
+
+  c64_fsquare_times(xx, x, 1);
+  c64_fsquare_times(zz, z, 1);
+  c64_fmul(x2, xx, zz);
+  c64_fdifference_backwards(zz, xx);  /* does zz = xx - zz */
+  c64_fscalar_product(zzz, zz, 121665);
+  c64_fsum(zzz, xx);
+  c64_fmul(z2, zz, zzz);
+}
+
+/* Conditionally swap two reduced-form limb arrays if 'iswap' is 1,
+ * but leave them unchanged if 'iswap' is 0, in constant time. */
+static void
+c64_swap_conditional(limb a[5], limb b[5], limb iswap)
+{
+  unsigned i;
+  const limb swap = -iswap;
+
+  for (i = 0; i < 5; ++i) {
+    const limb x = swap & (a[i] ^ b[i]);
+    a[i] ^= x;
+    b[i] ^= x;
+  }
+}
+
+/* Calculates nQ where Q is the x-coordinate of a point on the curve
+ *
+ *   resultx/resultz: the x coordinate of the resulting curve point
+ *     (short form)
+ *   n: a little endian, 32-byte number
+ *   q: a point of the curve (short form) */
+static void
+c64_cmult(limb *resultx, limb *resultz, const uint8_t *n, const limb *q)
+{
+  limb a[5] = {0}, b[5] = {1}, c[5] = {1}, d[5] = {0};
+  limb *nqpqx = a, *nqpqz = b, *nqx = c, *nqz = d, *t;
+  limb e[5] = {0}, f[5] = {1}, g[5] = {0}, h[5] = {1};
+  limb *nqpqx2 = e, *nqpqz2 = f, *nqx2 = g, *nqz2 = h;
+
+  unsigned i, j;
+
+  memcpy(nqpqx, q, sizeof(limb) * 5);
+
+  for (i = 0; i < 32; ++i) {
+    uint8_t byte = n[31 - i];
+    for (j = 0; j < 8; ++j) {
+      const limb bit = byte >> 7;
+
+      c64_swap_conditional(nqx, nqpqx, bit);
+      c64_swap_conditional(nqz, nqpqz, bit);
+      c64_fmonty(nqx2, nqz2,
+                 nqpqx2, nqpqz2,
+                 nqx, nqz,
+                 nqpqx, nqpqz,
+                 q);
+      c64_swap_conditional(nqx2, nqpqx2, bit);
+      c64_swap_conditional(nqz2, nqpqz2, bit);
+
+      t = nqx;
+      nqx = nqx2;
+      nqx2 = t;
+      t = nqz;
+      nqz = nqz2;
+      nqz2 = t;
+      t = nqpqx;
+      nqpqx = nqpqx2;
+      nqpqx2 = t;
+      t = nqpqz;
+      nqpqz = nqpqz2;
+      nqpqz2 = t;
+
+      byte <<= 1;
+    }
+  }
+
+  memcpy(resultx, nqx, sizeof(limb) * 5);
+  memcpy(resultz, nqz, sizeof(limb) * 5);
+}
+
+/* out = z^(p - 2), the inverse of z, by the same chain as crecip(). */
+static void
+c64_crecip(felem out, const felem z)
+{
+  felem a, t0, b, c;
+
+  /* 2 */ c64_fsquare_times(a, z, 1); /* a = 2 */
+  /* 8 */ c64_fsquare_times(t0, a, 2);
+  /* 9 */ c64_fmul(b, t0, z); /* b = 9 */
+  /* 11 */ c64_fmul(a, b, a); /* a = 11 */
+  /* 22 */ c64_fsquare_times(t0, a, 1);
+  /* 2^5 - 2^0 = 31 */ c64_fmul(b, t0, b);
+  /* 2^10 - 2^5 */ c64_fsquare_times(t0, b, 5);
+  /* 2^10 - 2^0 */ c64_fmul(b, t0, b);
+  /* 2^20 - 2^10 */ c64_fsquare_times(t0, b, 10);
+  /* 2^20 - 2^0 */ c64_fmul(c, t0, b);
+  /* 2^40 - 2^20 */ c64_fsquare_times(t0, c, 20);
+  /* 2^40 - 2^0 */ c64_fmul(t0, t0, c);
+  /* 2^50 - 2^10 */ c64_fsquare_times(t0, t0, 10);
+  /* 2^50 - 2^0 */ c64_fmul(b, t0, b);
+  /* 2^100 - 2^50 */ c64_fsquare_times(t0, b, 50);
+  /* 2^100 - 2^0 */ c64_fmul(c, t0, b);
+  /* 2^200 - 2^100 */ c64_fsquare_times(t0, c, 100);
+  /* 2^200 - 2^0 */ c64_fmul(t0, t0, c);
+  /* 2^250 - 2^50 */ c64_fsquare_times(t0, t0, 50);
+  /* 2^250 - 2^0 */ c64_fmul(t0, t0, b);
+  /* 2^255 - 2^5 */ c64_fsquare_times(t0, t0, 5);
+  /* 2^255 - 21 */ c64_fmul(out, t0, a);
+}
+
+static int
+curve25519_c64(
+        uint8_t *mypublic,
+        const uint8_t *secret,
+        const uint8_t *basepoint)
+{
+  limb bp[5], x[5], z[5], zmone[5];
+  uint8_t e[32];
+  int i;
+
+  for (i = 0; i < 32; ++i) e[i] = secret[i];
+  e[0] &= 248;
+  e[31] &= 127;
+  e[31] |= 64;
+
+  c64_fexpand(bp, basepoint);
+  c64_cmult(x, z, e, bp);
+  c64_crecip(zmone, z);
+  c64_fmul(z, x, zmone);
+  c64_fcontract(mypublic, z);
+  return 0;
+}
+
+/* Ladders run per batch, sharing one inversion. */
+#define C64_BATCH 8
+
+/* Return 1 if a is zero, else 0, in constant time. */
+static limb
+c64_fiszero(const felem a)
+{
+  uint8_t bytes[32];
+  unsigned i, acc = 0;
+  c64_fcontract(bytes, a);
+  for (i = 0; i < 32; i++)
+    acc |= bytes[i];
+  return (acc - 1) >> 8 & 1;
+}
+
+/* Copy b into a if flag is 1, leave a alone if it is 0, in constant
+ * time. */
+static void
+c64_fcmov(felem a, const felem b, limb flag)
+{
+  const limb mask = -flag;
+  unsigned i;
+  for (i = 0; i < 5; ++i)
+    a[i] ^= mask & (a[i] ^ b[i]);
+}
+
+/* Run the ladder for each element and recover every affine u with a
+ * single inversion using Montgomery's trick: invert the product of all
+ * the z, then peel off one z at a time. A z of zero (the point at
+ * infinity) is swapped for one so it doesn't zero out the product, and
+ * its result forced to zero, matching crecip(0) = 0. */
+static int
+curve25519_c64_batch(uint8_t *const mypublic[],
+                     const uint8_t *const secret[],
+                     const uint8_t *const basepoint[], int n)
+{
+  static const felem zero = {0};
+  static const felem one = {1};
+  felem x[C64_BATCH], z[C64_BATCH], acc[C64_BATCH], bp, inv, t;
+  limb infinity[C64_BATCH];
+  uint8_t e[32];
+  int i, j, m;
+
+  for (; n > 0; n -= m) {
+    m = n < C64_BATCH ? n : C64_BATCH;
+    for (i = 0; i < m; i++) {
+      for (j = 0; j < 32; ++j) e[j] = secret[i][j];
+      e[0] &= 248;
+      e[31] &= 127;
+      e[31] |= 64;
+      c64_fexpand(bp, basepoint[i]);
+      c64_cmult(x[i], z[i], e, bp);
+      infinity[i] = c64_fiszero(z[i]);
+      c64_fcmov(z[i], one, infinity[i]);
+      if (i)
+        c64_fmul(acc[i], acc[i - 1], z[i]);
+      else
+        memcpy(acc[i], z[i], sizeof(felem));
+    }
+
+    c64_crecip(inv, acc[m - 1]);
+    for (i = m - 1; i >= 0; i--) {
+      if (i) {
+        c64_fmul(t, inv, acc[i - 1]);
+        c64_fmul(inv, inv, z[i]);
+      } else {
+        memcpy(t, inv, sizeof(felem));
+      }
+      c64_fcmov(t, zero, infinity[i]);
+      c64_fmul(t, x[i], t);
+      c64_fcontract(mypublic[i], t);
+    }
+
+    mypublic += m;
+    secret += m;
+    basepoint += m;
+  }
+  return 0;
+}
+
+/* Fixed-base scalar multiplication:
+ *
+ * Rather than run the ladder on u = 9, compute the scalar multiple of
+ * the equivalent twisted Edwards point -x^2 + y^2 = 1 + dx^2y^2 from
+ * the precomputed table in curve25519-base.h, then map the result back
+ * to Montgomery form with u = (1 + y) / (1 - y). Points are in extended
+ * coordinates (X:Y:Z:T) with x = X/Z, y = Y/Z and T = XY/Z, using the
+ * addition and doubling formulas of Hisil et al. as in ref10. */
+
+/* Carry a number so that every limb is below 2^51 + 2^17. */
+static void
+c64_fcarry(felem t)
+{
+  t[1] += t[0] >> 51; t[0] &= MASK51;
+  t[2] += t[1] >> 51; t[1] &= MASK51;
+  t[3] += t[2] >> 51; t[2] &= MASK51;
+  t[4] += t[3] >> 51; t[3] &= MASK51;
+  t[0] += 19 * (t[4] >> 51); t[4] &= MASK51;
+}
+
+/* output = a + b, without carrying */
+static void
+c64_fadd(felem output, const felem a, const felem b)
+{
+  output[0] = a[0] + b[0];
+  output[1] = a[1] + b[1];
+  output[2] = a[2] + b[2];
+  output[3] = a[3] + b[3];
+  output[4] = a[4] + b[4];
+}
+
+/* output = a - b, carried. Assumes b[i] < 2^54 - 152. */
+static void
+c64_fsub(felem output, const felem a, const felem b)
+{
+  static const limb two54m152 = (((limb)1) << 54) - 152;
+  static const limb two54m8 = (((limb)1) << 54) - 8;
+
+  output[0] = a[0] + two54m152 - b[0];
+  output[1] = a[1] + two54m8 - b[1];
+  output[2] = a[2] + two54m8 - b[2];
+  output[3] = a[3] + two54m8 - b[3];
+  output[4] = a[4] + two54m8 - b[4];
+  c64_fcarry(output);
+}
+
+struct ge_p3 {
+  felem X, Y, Z, T;
+};
+
+/* A table entry: (y + x, y - x, 2dxy) */
+struct ge_precomp {
+  felem yplusx, yminusx, xy2d;
+};
+
+/* Convert the result (E, H, G, F) of an addition or doubling to
+ * extended coordinates. */
+static void
+ge_p1p1_to_p3(struct ge_p3 *r, const felem e, const felem h,
+              const felem g, const felem f)
+{
+  c64_fmul(r->X, e, f);
+  c64_fmul(r->Y, g, h);
+  c64_fmul(r->Z, g, f);
+  c64_fmul(r->T, e, h);
+}
+
+/* r = p + q */
+static void
+ge_madd(struct ge_p3 *r, const struct ge_p3 *p, const struct ge_precomp *q)
+{
+  felem a, b, c, d, e, f, g, h;
+
+  c64_fadd(a, p->Y, p->X);
+  c64_fsub(b, p->Y, p->X);
+  c64_fmul(a, a, q->yplusx);
+  c64_fmul(b, b, q->yminusx);
+  c64_fmul(c, q->xy2d, p->T);
+  c64_fadd(d, p->Z, p->Z);
+  c64_fsub(e, a, b);
+  c64_fadd(h, a, b);
+  c64_fadd(g, d, c);
+  c64_fsub(f, d, c);
+  ge_p1p1_to_p3(r, e, h, g, f);
+}
+
+/* r = 2p */
+static void
+ge_dbl(struct ge_p3 *r, const struct ge_p3 *p)
+{
+  felem xx, yy, b, a, e, f, g, h;
+
+  c64_fsquare_times(xx, p->X, 1);
+  c64_fsquare_times(yy, p->Y, 1);
+  c64_fsquare_times(b, p->Z, 1);
+  c64_fadd(b, b, b);
+  c64_fadd(a, p->X, p->Y);
+  c64_fsquare_times(a, a, 1);
+  c64_fadd(h, yy, xx);
+  c64_fsub(g, yy, xx);
+  c64_fsub(e, a, h);
+  c64_fsub(f, b, g);
+  ge_p1p1_to_p3(r, e, h, g, f);
+}
+
+/* Expand one 96-byte table entry into limbs. */
+static void
+c64_precomp_expand(struct ge_precomp *out, const uint8_t *entry)
+{
+  c64_fexpand(out->yplusx, entry);
+  c64_fexpand(out->yminusx, entry + 32);
+  c64_fexpand(out->xy2d, entry + 64);
+}
+
+/* Expand a table in the layout of curve25519-base.h into limbs. */
+static void
+c64_table_expand(struct ge_precomp out[8][8], const uint8_t *table)
+{
+  int j, m;
+  for (j = 0; j < 8; j++)
+    for (m = 0; m < 8; m++)
+      c64_precomp_expand(&out[j][m], table + (j * 8 + m) * 96);
+}
+
+/* Set t to b times the base of ROW for -8 <= b <= 8, in constant
+ * time. */
+static void
+ge_select(struct ge_precomp *t, const struct ge_precomp row[8],
+          signed char b)
+{
+  static const felem zero = {0};
+  struct ge_precomp minust;
+  limb bnegative = (limb)(unsigned char)b >> 7;
+  limb babs = b - (((-bnegative) & b) << 1);
+  limb m;
+
+  memset(t, 0, sizeof(*t));
+  t->yplusx[0] = 1;
+  t->yminusx[0] = 1;
+  for (m = 1; m <= 8; m++) {
+    const limb eq = ((babs ^ m) - 1) >> 63;
+    c64_fcmov(t->yplusx, row[m - 1].yplusx, eq);
+    c64_fcmov(t->yminusx, row[m - 1].yminusx, eq);
+    c64_fcmov(t->xy2d, row[m - 1].xy2d, eq);
+  }
+  memcpy(minust.yplusx, t->yminusx, sizeof(felem));
+  memcpy(minust.yminusx, t->yplusx, sizeof(felem));
+  c64_fsub(minust.xy2d, zero, t->xy2d);
+  c64_fcmov(t->yplusx, minust.yplusx, bnegative);
+  c64_fcmov(t->yminusx, minust.yminusx, bnegative);
+  c64_fcmov(t->xy2d, minust.xy2d, bnegative);
+}
+
+/* Multiply the point described by TABLE by the clamped secret. */
+static void
+c64_table_mult(uint8_t *mypublic, const uint8_t *secret,
+               struct ge_precomp table[8][8])
+{
+  struct ge_p3 h;
+  struct ge_precomp t;
+  signed char e[64];
+  signed char carry;
+  felem u, v;
+  int i, j, k;
+
+  /* Clamp, then write the scalar as 64 signed radix-16 digits, each
+   * between -8 and 8, least significant first. */
+  for (i = 0; i < 32; ++i) {
+    uint8_t a = secret[i];
+    if (i == 0) a &= 248;
+    if (i == 31) a = (a & 127) | 64;
+    e[2 * i + 0] = a & 15;
+    e[2 * i + 1] = (a >> 4) & 15;
+  }
+  carry = 0;
+  for (i = 0; i < 63; ++i) {
+    e[i] += carry;
+    carry = e[i] + 8;
+    carry >>= 4;
+    e[i] -= carry << 4;
+  }
+  e[63] += carry;
+
+  /* h = sum of e[8j + k] * 16^k * (16^(8j) * P), by Horner's rule
+   * over k, starting from the neutral element (0, 1). */
+  memset(&h, 0, sizeof(h));
+  h.Y[0] = 1;
+  h.Z[0] = 1;
+  for (k = 7; k >= 0; --k) {
+    if (k < 7)
+      for (i = 0; i < 4; ++i)
+        ge_dbl(&h, &h);
+    for (j = 0; j < 8; ++j) {
+      ge_select(&t, table[j], e[8 * j + k]);
+      ge_madd(&h, &h, &t);
+    }
+  }
+
+  /* u = (Z + Y) / (Z - Y) */
+  c64_fadd(u, h.Z, h.Y);
+  c64_fsub(v, h.Z, h.Y);
+  c64_crecip(v, v);
+  c64_fmul(u, u, v);
+  c64_fcontract(mypublic, u);
+}
+
+/* The table in curve25519-base.h, expanded on first use. */
+static struct ge_precomp c64_base[8][8];
+static int c64_base_ready;
+
+static int
+curve25519_c64_base(uint8_t *mypublic, const uint8_t *secret)
+{
+  if (!c64_base_ready) {
+    c64_table_expand(c64_base, curve25519_base[0][0][0]);
+    c64_base_ready = 1;
+  }
+  c64_table_mult(mypublic, secret, c64_base);
+  return 0;
+}
+
+static int
+curve25519_c64_table(uint8_t *mypublic, const uint8_t *secret,
+                     const uint8_t *table)
+{
+  struct ge_precomp expanded[8][8];
+  c64_table_expand(expanded, table);
+  c64_table_mult(mypublic, secret, expanded);
+  return 0;
+}
+
+/* The Edwards curve constant d = -121665/121666 */
+static const uint8_t c64_d[32] = {
+  0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75,
+  0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+  0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c,
+  0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52
+};
+
+/* sqrt(-1) = 2^((p - 1) / 4) */
+static const uint8_t c64_sqrtm1[32] = {
+  0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4,
+  0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+  0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b,
+  0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b
+};
+
+/* out = z^((p - 5) / 8) = z^(2^252 - 3), for square roots */
+static void
+c64_fpow22523(felem out, const felem z)
+{
+  felem a, t0, b, c;
+
+  /* 2 */ c64_fsquare_times(a, z, 1);
+  /* 8 */ c64_fsquare_times(t0, a, 2);
+  /* 9 */ c64_fmul(b, t0, z);
+  /* 11 */ c64_fmul(a, b, a);
+  /* 22 */ c64_fsquare_times(t0, a, 1);
+  /* 2^5 - 2^0 = 31 */ c64_fmul(b, t0, b);
+  /* 2^10 - 2^5 */ c64_fsquare_times(t0, b, 5);
+  /* 2^10 - 2^0 */ c64_fmul(b, t0, b);
+  /* 2^20 - 2^10 */ c64_fsquare_times(t0, b, 10);
+  /* 2^20 - 2^0 */ c64_fmul(c, t0, b);
+  /* 2^40 - 2^20 */ c64_fsquare_times(t0, c, 20);
+  /* 2^40 - 2^0 */ c64_fmul(t0, t0, c);
+  /* 2^50 - 2^10 */ c64_fsquare_times(t0, t0, 10);
+  /* 2^50 - 2^0 */ c64_fmul(b, t0, b);
+  /* 2^100 - 2^50 */ c64_fsquare_times(t0, b, 50);
+  /* 2^100 - 2^0 */ c64_fmul(c, t0, b);
+  /* 2^200 - 2^100 */ c64_fsquare_times(t0, c, 100);
+  /* 2^200 - 2^0 */ c64_fmul(t0, t0, c);
+  /* 2^250 - 2^50 */ c64_fsquare_times(t0, t0, 50);
+  /* 2^250 - 2^0 */ c64_fmul(t0, t0, b);
+  /* 2^252 - 2^2 */ c64_fsquare_times(t0, t0, 2);
+  /* 2^252 - 3 */ c64_fmul(out, t0, z);
+}
+
+/* Return 1 if a and b are the same field element, else 0. */
+static int
+c64_fequal(const felem a, const felem b)
+{
+  uint8_t x[32], y[32];
+  c64_fcontract(x, a);
+  c64_fcontract(y, b);
+  return !memcmp(x, y, 32);
+}
+
+/* Store the projective point p as a 96-byte table entry. */
+static void
+c64_table_entry(uint8_t *entry, const struct ge_p3 *p)
+{
+  felem x, y, t, d;
+
+  c64_crecip(t, p->Z);
+  c64_fmul(x, p->X, t);
+  c64_fmul(y, p->Y, t);
+  c64_fadd(t, y, x);
+  c64_fcontract(entry, t);
+  c64_fsub(t, y, x);
+  c64_fcontract(entry + 32, t);
+  c64_fexpand(d, c64_d);
+  c64_fmul(t, x, y);
+  c64_fmul(t, t, d);
+  c64_fadd(t, t, t);
+  c64_fcontract(entry + 64, t);
+}
+
+/* Build a table in the layout of curve25519-base.h for the point u.
+ *
+ * The Edwards point has y = (u - 1) / (u + 1), and either square root
+ * of x^2 = (y^2 - 1) / (dy^2 + 1) will do, since negating a point
+ * doesn't change u. Fails for u = -1, which has no Edwards image, and
+ * for points on the twist, which have no such x. This runs once per
+ * key, so every entry is simply made affine with its own inversion. */
+static int
+curve25519_c64_table_init(uint8_t *table, const uint8_t *point)
+{
+  static const felem zero = {0};
+  static const felem one = {1};
+  felem u, x, y, n, v, v3, t;
+  struct ge_p3 q, r;
+  struct ge_precomp qp;
+  int j, m;
+
+  c64_fexpand(u, point);
+  c64_fadd(t, u, one);
+  if (c64_fequal(t, zero))
+    return -1;
+  c64_crecip(t, t);
+  c64_fsub(y, u, one);
+  c64_fmul(y, y, t);
+
+  /* x = n v^3 (n v^7)^((p - 5) / 8), where x^2 = n / v */
+  c64_fexpand(t, c64_d);
+  c64_fsquare_times(n, y, 1);
+  c64_fmul(v, n, t);
+  c64_fadd(v, v, one);
+  c64_fsub(n, n, one);
+  c64_fsquare_times(v3, v, 1);
+  c64_fmul(v3, v3, v);
+  c64_fsquare_times(x, v3, 1);
+  c64_fmul(x, x, v);
+  c64_fmul(x, x, n);
+  c64_fpow22523(x, x);
+  c64_fmul(x, x, v3);
+  c64_fmul(x, x, n);
+
+  /* Check v x^2 = n, or fix up when it's -n. */
+  c64_fsquare_times(t, x, 1);
+  c64_fmul(t, t, v);
+  if (!c64_fequal(t, n)) {
+    c64_fsub(t, zero, t);
+    if (!c64_fequal(t, n))
+      return -1;
+    c64_fexpand(t, c64_sqrtm1);
+    c64_fmul(x, x, t);
+  }
+
+  /* Row j holds the multiples of q = 16^(8j) P. */
+  memcpy(q.X, x, sizeof(felem));
+  memcpy(q.Y, y, sizeof(felem));
+  memcpy(q.Z, one, sizeof(felem));
+  c64_fmul(q.T, x, y);
+  for (j = 0; j < 8; j++) {
+    uint8_t *row = table + j * 8 * 96;
+    if (j)
+      for (m = 0; m < 32; m++)
+        ge_dbl(&q, &q);
+    c64_table_entry(row, &q);
+    c64_precomp_expand(&qp, row);
+    r = q;
+    for (m = 1; m < 8; m++) {
+      ge_madd(&r, &r, &qp);
+      c64_table_entry(row + m * 96, &r);
+    }
+  }
+  return 0;
+}
+#endif /* __SIZEOF_INT128__ */
+
+static int
+curve25519_ref_base(uint8_t *mypublic, const uint8_t *secret)
+{
+  static const uint8_t basepoint[32] = {9};
+  return curve25519_ref(mypublic, secret, basepoint);
+}
+
+static int
+curve25519_ref_batch(uint8_t *const mypublic[],
+                     const uint8_t *const secret[],
+                     const uint8_t *const basepoint[], int n)
+{
+  int i;
+  for (i = 0; i < n; i++)
+    curve25519_ref(mypublic[i], secret[i], basepoint[i]);
+  return 0;
+}
+
+typedef int (*curve25519_fn)(uint8_t *, const uint8_t *, const uint8_t *);
+typedef int (*curve25519_base_fn)(uint8_t *, const uint8_t *);
+typedef int (*curve25519_batch_fn)(uint8_t *const[], const uint8_t *const[],
+                                   const uint8_t *const[], int);
+
+/* Best first, matching curve25519_kernels. */
+static const curve25519_fn curve25519_impls[] = {
+#ifdef CURVE25519_C64
+  curve25519_c64,
+#endif
+  curve25519_ref
+};
+
+static const curve25519_base_fn curve25519_base_impls[] = {
+#ifdef CURVE25519_C64
+  curve25519_c64_base,
+#endif
+  curve25519_ref_base
+};
+
+static const curve25519_batch_fn curve25519_batch_impls[] = {
+#ifdef CURVE25519_C64
+  curve25519_c64_batch,
+#endif
+  curve25519_ref_batch
+};
+
+/* Kernels without table support have null entries. */
+static const curve25519_fn curve25519_table_impls[] = {
+#ifdef CURVE25519_C64
+  curve25519_c64_table,
+#endif
+  0
+};
+
+static const curve25519_base_fn curve25519_table_init_impls[] = {
+#ifdef CURVE25519_C64
+  curve25519_c64_table_init,
+#endif
+  0
+};
+
+const struct cpu_kernel curve25519_kernels[] = {
+#ifdef CURVE25519_C64
+  {"c64", 0},
+#endif
+  {"portable", 0},
+  {0, 0}
+};
+
+static int curve25519_current = -1;
+static curve25519_fn curve25519_impl;
+static curve25519_base_fn curve25519_base_impl;
+
+void
+curve25519_kernel_use(int kernel)
+{
+  curve25519_current = kernel;
+  curve25519_impl = curve25519_impls[kernel];
+  curve25519_base_impl = curve25519_base_impls[kernel];
+}
+
+int
+curve25519_kernel_current(void)
+{
+  if (curve25519_current < 0)
+    curve25519_kernel_use(cpu_best(curve25519_kernels));
+  return curve25519_current;
+}
+
+int
+curve25519_donna(uint8_t *mypublic, const uint8_t *secret,
+                 const uint8_t *basepoint)
+{
+  if (!curve25519_impl)
+    curve25519_kernel_current();
+  return curve25519_impl(mypublic, secret, basepoint);
+}
+
+int
+curve25519_donna_base(uint8_t *mypublic, const uint8_t *secret)
+{
+  if (!curve25519_base_impl)
+    curve25519_kernel_current();
+  return curve25519_base_impl(mypublic, secret);
+}
+
+int
+curve25519_table(uint8_t *table, const uint8_t *basepoint)
+{
+  curve25519_base_fn f;
+  f = curve25519_table_init_impls[curve25519_kernel_current()];
+  return f ? f(table, basepoint) : -1;
+}
+
+int
+curve25519_donna_table(uint8_t *mypublic, const uint8_t *secret,
+                       const uint8_t *table)
+{
+  curve25519_fn f;
+  f = curve25519_table_impls[curve25519_kernel_current()];
+  return f ? f(mypublic, secret, table) : -1;
+}
+
+int
+curve25519_donna_batch(uint8_t *const mypublic[],
+                       const uint8_t *const secret[],
+                       const uint8_t *const basepoint[], int n)
+{
+  curve25519_batch_fn f;
+  f = curve25519_batch_impls[curve25519_kernel_current()];
+  return f(mypublic, secret, basepoint, n);
+}
@@ -0,0 +1,39 @@
+#ifndef CURVE25519_DONNA_H
+#define CURVE25519_DONNA_H
+
+#include "../config.h"
+#include "cpu.h"
+
+int curve25519_donna(uint8_t *mypublic, const uint8_t *secret,
+                     const uint8_t *basepoint);
+
+/* Same as curve25519_donna() with the base point u = 9, but faster. */
+int curve25519_donna_base(uint8_t *mypublic, const uint8_t *secret);
+
+/* Compute mypublic[i] = curve25519_donna(secret[i], basepoint[i]) for
+ * each of the n elements, faster than one at a time. Each output may
+ * alias only its own inputs. */
+int curve25519_donna_batch(uint8_t *const mypublic[],
+                           const uint8_t *const secret[],
+                           const uint8_t *const basepoint[], int n);
+
+/* Size of a precomputed table for one point. */
+#define CURVE25519_TABLE_SIZE (8 * 8 * 96)
+
+/* Fill in a table for fast multiplication of basepoint. Returns 0 on
+ * success, or -1 if the selected kernel doesn't support tables or the
+ * point can't have one. */
+int curve25519_table(uint8_t *table, const uint8_t *basepoint);
+
+/* Same as curve25519_donna() using the table of the base point made by
+ * curve25519_table(). Returns -1 if the selected kernel doesn't support
+ * tables, leaving mypublic untouched. */
+int curve25519_donna_table(uint8_t *mypublic, const uint8_t *secret,
+                           const uint8_t *table);
+
+/* Runtime kernel selection, see cpu.h. */
+extern const struct cpu_kernel curve25519_kernels[];
+void curve25519_kernel_use(int kernel);
+int curve25519_kernel_current(void);
+
+#endif /* CURVE25519_DONNA_H */
@@ -3,7 +3,7 @@ static const char *docs_usage[] = {
 #if ENCHIVE_OPTION_AGENT
 "              [-a|--agent[=seconds]] [-A|--no-agent]",
 #endif
-"              [--version] [--help]",
+"              [-v|--verbose] [--version] [--help]",
 "              <command> [args]",
 "",
 "Commands (unique prefixes accepted):",
@@ -11,6 +11,8 @@ static const char *docs_usage[] = {
 "  archive       archive using the public key",
 "  extract       extract from an archive using the secret key",
 "  fingerprint   print the master keypair fingerprint",
+"  table         precompute a table to speed up archiving",
+"  bench         measure crypto performance on this machine",
 "",
 "  -p, --pubkey <file>        set the public key file",
 "  -s, --seckey <file>        set the secret key file",
@@ -30,9 +32,11 @@ static const char *docs_usage[] = {
 #else
     "",
 #endif
+"  --kernel <list>            choose crypto kernels, or \"list\" them",
+"  -v, --verbose              print informational messages",
 "  --version                  display version information",
 "  --help                     display this usage information",
 "",
 "Enchive archives files by encrypting them to yourself using your",
-"public key. It uses ChaCha20, Curve25519, and HMAC-SHA256.",
+"public key. It uses ChaCha, Curve25519, and HMAC-SHA256.",
 0};
@@ -4,21 +4,24 @@
 #include <string.h>
 #include <stdarg.h>
 #include <errno.h>
+#include <time.h>
 
 #include "docs.h"
+#include "cpu.h"
 #include "sha256.h"
 #include "chacha.h"
+#include "poly1305.h"
+#include "curve25519-donna.h"
 #include "optparse.h"
 
 #ifdef _MSC_VER
 #  pragma comment(lib, "advapi32.lib")
 #endif
 
-int curve25519_donna(uint8_t *p, const uint8_t *s, const uint8_t *b);
-
 /* Global options. */
 static char *global_pubkey = 0;
 static char *global_seckey = 0;
+static int global_verbose = 0;
 
 #if ENCHIVE_AGENT_DEFAULT_ENABLED
 static int global_agent_timeout = ENCHIVE_AGENT_TIMEOUT;
@@ -121,6 +124,22 @@ warning(const char *fmt, ...)
     va_end(ap);
 }
 
+/**
+ * Print an informational message when running with --verbose.
+ */
+static void
+info(const char *fmt, ...)
+{
+    va_list ap;
+    if (!global_verbose)
+        return;
+    va_start(ap, fmt);
+    fprintf(stderr, "info: ");
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    va_end(ap);
+}
+
 /**
  * Return a copy of S, which may be NULL.
  * Abort the program if out of memory.
@@ -193,10 +212,11 @@ static int agent_run(const uint8_t *key, const uint8_t *id);
 #include <sys/socket.h>
 
 /**
- * Fill ADDR with a unix domain socket name for the agent.
+ * Fill ADDR with a unix domain socket name for the agent, or for
+ * another background service given a SUFFIX.
  */
 static int
-agent_addr(struct sockaddr_un *addr, const uint8_t *iv)
+agent_addr(struct sockaddr_un *addr, const uint8_t *iv, const char *suffix)
 {
     char *dir = getenv("XDG_RUNTIME_DIR");
     if (!dir) {
@@ -206,12 +226,13 @@ agent_addr(struct sockaddr_un *addr, const uint8_t *iv)
     }
 
     addr->sun_family = AF_UNIX;
-    if (strlen(dir) + 1 + 16 + 1 > sizeof(addr->sun_path)) {
+    if (strlen(dir) + 1 + 16 + strlen(suffix) + 1 > sizeof(addr->sun_path)) {
         warning("agent socket path too long -- %s", dir);
         return 0;
     } else {
-        sprintf(addr->sun_path, "%s/%02x%02x%02x%02x%02x%02x%02x%02x", dir,
-                iv[0], iv[1], iv[2], iv[3], iv[4], iv[5], iv[6], iv[7]);
+        sprintf(addr->sun_path, "%s/%02x%02x%02x%02x%02x%02x%02x%02x%s", dir,
+                iv[0], iv[1], iv[2], iv[3], iv[4], iv[5], iv[6], iv[7],
+                suffix);
         return 1;
     }
 }
@@ -222,7 +243,7 @@ agent_read(uint8_t *key, const uint8_t *iv)
     int success;
     struct sockaddr_un addr;
     int fd = socket(AF_UNIX, SOCK_STREAM, 0);
-    if (!agent_addr(&addr, iv)) {
+    if (!agent_addr(&addr, iv, "")) {
         close(fd);
         return 0;
     }
@@ -248,7 +269,7 @@ agent_run(const uint8_t *key, const uint8_t *iv)
         return 0;
     }
 
-    if (!agent_addr(&addr, iv))
+    if (!agent_addr(&addr, iv, ""))
         return 0;
 
     pid = fork();
@@ -791,6 +812,542 @@ hmac_final(SHA256_CTX *ctx, const uint8_t *key, uint8_t *hash)
     sha256_final(ctx, hash);
 }
 
+/* Bytes per fused cipher/MAC step, small enough to stay in L1. */
+#define FUSED_CHUNK (CHACHA_BLOCKLENGTH * 64)
+
+/**
+ * Run the cipher over LEN bytes from IN to OUT while feeding IN into
+ * HMAC, a cache-resident chunk at a time, so each byte is brought in
+ * from memory only once. Consumes the same keystream as a single
+ * chacha_encrypt() call of LEN bytes. This encrypts format 3, which
+ * authenticates the plaintext.
+ */
+static void
+fused_mac_in(chacha_ctx *ctx, SHA256_CTX *hmac,
+             const uint8_t *in, uint8_t *out, size_t len)
+{
+    while (len) {
+        uint32_t z = len < FUSED_CHUNK ? len : FUSED_CHUNK;
+        sha256_update(hmac, in, z);
+        chacha_encrypt(ctx, in, out, z);
+        in += z;
+        out += z;
+        len -= z;
+    }
+}
+
+/**
+ * Like fused_mac_in(), but feed OUT into HMAC instead, as when
+ * decrypting format 3.
+ */
+static void
+fused_mac_out(chacha_ctx *ctx, SHA256_CTX *hmac,
+              const uint8_t *in, uint8_t *out, size_t len)
+{
+    while (len) {
+        uint32_t z = len < FUSED_CHUNK ? len : FUSED_CHUNK;
+        chacha_encrypt(ctx, in, out, z);
+        sha256_update(hmac, out, z);
+        in += z;
+        out += z;
+        len -= z;
+    }
+}
+
+/**
+ * Like fused_mac_in(), but with Poly1305 instead of HMAC.
+ */
+static void
+fused_poly_in(chacha_ctx *ctx, poly1305_ctx *poly,
+              const uint8_t *in, uint8_t *out, size_t len)
+{
+    while (len) {
+        uint32_t z = len < FUSED_CHUNK ? len : FUSED_CHUNK;
+        poly1305_update(poly, in, z);
+        chacha_encrypt(ctx, in, out, z);
+        in += z;
+        out += z;
+        len -= z;
+    }
+}
+
+/**
+ * Like fused_mac_out(), but with Poly1305 instead of HMAC.
+ */
+static void
+fused_poly_out(chacha_ctx *ctx, poly1305_ctx *poly,
+               const uint8_t *in, uint8_t *out, size_t len)
+{
+    while (len) {
+        uint32_t z = len < FUSED_CHUNK ? len : FUSED_CHUNK;
+        chacha_encrypt(ctx, in, out, z);
+        poly1305_update(poly, out, z);
+        in += z;
+        out += z;
+        len -= z;
+    }
+}
+
+/* Format 4 splits the data into segments of SEGMENT_SIZE plaintext
+ * bytes, each followed by its own tag, and always ends with a short
+ * (possibly empty) final segment:
+ *
+ *   ciphertext[SEGMENT_SIZE] tag   (repeated)
+ *   ciphertext[< SEGMENT_SIZE] tag (final)
+ *
+ * Segment i is enciphered with the keystream starting at block
+ * i * SEGMENT_SIZE / CHACHA_BLOCKLENGTH, exactly as in format 3, and
+ * its tag is the HMAC of a prefix -- its 64-bit big-endian index and
+ * a byte that is 1 for the final segment and 0 otherwise -- and its
+ * ciphertext. So any segment can be checked and deciphered on its
+ * own, in any order, while reordering, truncating, or extending the
+ * archive still fails authentication.
+ *
+ * Format 5 has the same layout, but with the 16-byte Poly1305 tags of
+ * the RFC 8439 AEAD construction, taking the prefix as associated
+ * data. Each segment is a separate message with its own one-time
+ * Poly1305 key: segment i starts at keystream block
+ * i * (SEGMENT_SIZE / CHACHA_BLOCKLENGTH + 1), whose first 32 bytes
+ * are the key, and the data is enciphered from the following block.
+ *
+ * Formats 7 and 8 are format 4 with ChaCha12 and ChaCha20 in place of
+ * the 8-round cipher of the earlier formats. Since these otherwise
+ * share a layout, the prefix carries one more byte, the format
+ * version, so an archive can't be passed off as another of them.
+ */
+#define SEGMENT_SIZE   (CHACHA_BLOCKLENGTH * 1024)
+#define SEGMENT_PREFIX 9
+
+/* Largest tag of any format, for sizing buffers. */
+#define SEGMENT_TAG_MAX SHA256_BLOCK_SIZE
+
+/**
+ * Return the length of the tag after each segment in format VERSION,
+ * or 0 if it isn't segmented.
+ */
+static size_t
+segment_tag(int version)
+{
+    switch (version) {
+        case 4:
+        case 7:
+        case 8:
+            return SHA256_BLOCK_SIZE;
+        case 5:
+            return POLY1305_TAGLENGTH;
+    }
+    return 0;
+}
+
+/**
+ * Set up CTX to encipher the data of a format VERSION archive.
+ */
+static void
+cipher_init(chacha_ctx *ctx, const uint8_t *key, const uint8_t *iv,
+            int version)
+{
+    chacha_keysetup(ctx, key, 256);
+    chacha_ivsetup(ctx, iv);
+    switch (version) {
+        case 7:
+            chacha_rounds(ctx, 12);
+            break;
+        case 8:
+            chacha_rounds(ctx, 20);
+            break;
+    }
+}
+
+/**
+ * Encrypt (DECRYPT = 0) or decrypt LEN bytes from IN to OUT as the
+ * format 5 segment starting with PREFIX, storing its tag in TAG.
+ */
+static void
+segment_poly(chacha_ctx *ctx, uint64_t index, const uint8_t *prefix,
+             int decrypt, const uint8_t *in, uint8_t *out, size_t len,
+             uint8_t *tag)
+{
+    static const uint8_t zero[CHACHA_BLOCKLENGTH];
+    uint8_t block[CHACHA_BLOCKLENGTH];
+    uint8_t lengths[16];
+    poly1305_ctx poly[1];
+    int i;
+
+    chacha_seek(ctx, index * (SEGMENT_SIZE / CHACHA_BLOCKLENGTH + 1));
+    chacha_encrypt(ctx, zero, block, sizeof(block));
+    poly1305_init(poly, block);
+    memset(block, 0, sizeof(block));
+
+    poly1305_update(poly, prefix, SEGMENT_PREFIX);
+    poly1305_update(poly, zero, 16 - SEGMENT_PREFIX);
+    if (decrypt)
+        fused_poly_in(ctx, poly, in, out, len);
+    else
+        fused_poly_out(ctx, poly, in, out, len);
+    poly1305_update(poly, zero, (16 - len % 16) % 16);
+
+    for (i = 0; i < 8; i++) {
+        lengths[i] = (uint64_t)SEGMENT_PREFIX >> (i * 8);
+        lengths[i + 8] = (uint64_t)len >> (i * 8);
+    }
+    poly1305_update(poly, lengths, sizeof(lengths));
+    poly1305_finish(poly, tag);
+}
+
+/**
+ * Encrypt (DECRYPT = 0) or decrypt LEN bytes of whole format VERSION
+ * segments at IN, the first being segment INDEX, into OUT. Every
+ * segment is full size unless FINAL, in which case IN ends with the
+ * final segment. Returns the number of bytes written to OUT. When
+ * decrypting, stops at the first segment that fails authentication,
+ * setting *BAD, with only the segments before it written.
+ */
+static size_t
+segment_crypt(const uint8_t *key, chacha_ctx *ctx, int version,
+              uint64_t index, int decrypt, int final,
+              const uint8_t *in, uint8_t *out, size_t len, int *bad)
+{
+    size_t taglen = segment_tag(version);
+    size_t record = decrypt ? SEGMENT_SIZE + taglen : SEGMENT_SIZE;
+    size_t n = 0;
+
+    *bad = 0;
+    while (len || final) {
+        uint8_t prefix[SEGMENT_PREFIX + 1];
+        uint8_t tag[SEGMENT_TAG_MAX];
+        int last = len < record;
+        size_t z = last ? len : record;
+        int i;
+
+        if (decrypt) {
+            if (z < taglen) {
+                *bad = 1;
+                break;
+            }
+            z -= taglen;
+        }
+
+        for (i = 0; i < 8; i++)
+            prefix[i] = index >> (56 - i * 8);
+        prefix[8] = last;
+        prefix[9] = version;
+
+        if (version == 5) {
+            segment_poly(ctx, index, prefix, decrypt, in, out, z, tag);
+        } else {
+            SHA256_CTX hmac[1];
+            hmac_init(hmac, key);
+            sha256_update(hmac, prefix, SEGMENT_PREFIX + (version >= 7));
+            chacha_seek(ctx, index * (SEGMENT_SIZE / CHACHA_BLOCKLENGTH));
+            if (decrypt)
+                fused_mac_in(ctx, hmac, in, out, z);
+            else
+                fused_mac_out(ctx, hmac, in, out, z);
+            hmac_final(hmac, key, tag);
+        }
+
+        if (decrypt) {
+            if (memcmp(tag, in + z, taglen) != 0) {
+                *bad = 1;
+                break;
+            }
+            in += z + taglen;
+            out += z;
+            n += z;
+            len -= z + taglen;
+        } else {
+            memcpy(out + z, tag, taglen);
+            in += z;
+            out += z + taglen;
+            n += z + taglen;
+            len -= z;
+        }
+        index++;
+        if (last)
+            break;
+    }
+    return n;
+}
+
+/* Format 6 has the layout of format 3, the ciphertext followed by a
+ * single tag, but the tag is the root of a two-level hash tree so
+ * that it can be computed in parallel. The ciphertext is split into
+ * leaves of TREE_LEAF bytes, always ending with a short (possibly
+ * empty) leaf. Leaf i's tag is the HMAC of a zero byte, i as 64-bit
+ * big-endian, and the leaf. The root is the HMAC of a one byte, every
+ * leaf tag in order, and the ciphertext length as 64-bit big-endian.
+ */
+#define TREE_LEAF SEGMENT_SIZE
+
+struct tree {
+    SHA256_CTX root;
+    SHA256_CTX leaf;    /* the open leaf, for tree_update() */
+    const uint8_t *key;
+    uint64_t index;     /* leaves added to the root */
+    uint64_t length;    /* bytes in those leaves */
+    size_t fill;        /* bytes in the open leaf */
+    int done;           /* the final leaf has been added */
+};
+
+/**
+ * Start HMAC context LEAF for leaf INDEX.
+ */
+static void
+tree_begin(SHA256_CTX *leaf, const uint8_t *key, uint64_t index)
+{
+    uint8_t prefix[9];
+    int i;
+    prefix[0] = 0;
+    for (i = 0; i < 8; i++)
+        prefix[i + 1] = index >> (56 - i * 8);
+    hmac_init(leaf, key);
+    sha256_update(leaf, prefix, sizeof(prefix));
+}
+
+#if ENCHIVE_OPTION_THREADS
+/**
+ * Compute the tags of the leaves in LEN bytes at DATA, the first
+ * being leaf INDEX, into TAGS. Every leaf is full size unless FINAL,
+ * in which case DATA ends with the final leaf. Returns the number of
+ * tags, which independent callers can combine with tree_add().
+ */
+static size_t
+tree_leaves(const uint8_t *key, uint64_t index, int final,
+            const uint8_t *data, size_t len, uint8_t *tags)
+{
+    size_t n = 0;
+    while (len || final) {
+        SHA256_CTX leaf[1];
+        size_t z = len < TREE_LEAF ? len : TREE_LEAF;
+        tree_begin(leaf, key, index + n);
+        sha256_update(leaf, data, z);
+        hmac_final(leaf, key, tags + n++ * SHA256_BLOCK_SIZE);
+        data += z;
+        len -= z;
+        if (z < TREE_LEAF)
+            break;
+    }
+    return n;
+}
+#endif /* ENCHIVE_OPTION_THREADS */
+
+static void
+tree_init(struct tree *t, const uint8_t *key)
+{
+    static const uint8_t one[1] = {1};
+    hmac_init(&t->root, key);
+    sha256_update(&t->root, one, sizeof(one));
+    t->key = key;
+    t->index = 0;
+    t->length = 0;
+    t->fill = 0;
+    t->done = 0;
+    tree_begin(&t->leaf, key, 0);
+}
+
+/**
+ * Add the next leaf's TAG, for a leaf of LEN bytes, to the root.
+ */
+static void
+tree_add(struct tree *t, const uint8_t *tag, size_t len)
+{
+    sha256_update(&t->root, tag, SHA256_BLOCK_SIZE);
+    t->index++;
+    t->length += len;
+    t->done = len < TREE_LEAF;
+    if (!t->done)
+        tree_begin(&t->leaf, t->key, t->index);
+}
+
+/**
+ * Hash the next LEN bytes of ciphertext one leaf at a time.
+ */
+static void
+tree_update(struct tree *t, const uint8_t *data, size_t len)
+{
+    while (len) {
+        size_t z = TREE_LEAF - t->fill;
+        if (z > len)
+            z = len;
+        sha256_update(&t->leaf, data, z);
+        t->fill += z;
+        data += z;
+        len -= z;
+        if (t->fill == TREE_LEAF) {
+            uint8_t tag[SHA256_BLOCK_SIZE];
+            hmac_final(&t->leaf, t->key, tag);
+            t->fill = 0;
+            tree_add(t, tag, TREE_LEAF);
+        }
+    }
+}
+
+/**
+ * Close the final leaf, unless it was already added, and store the
+ * root in MAC.
+ */
+static void
+tree_final(struct tree *t, uint8_t *mac)
+{
+    uint8_t length[8];
+    int i;
+    if (!t->done) {
+        uint8_t tag[SHA256_BLOCK_SIZE];
+        hmac_final(&t->leaf, t->key, tag);
+        tree_add(t, tag, t->fill);
+    }
+    for (i = 0; i < 8; i++)
+        length[i] = t->length >> (56 - i * 8);
+    sha256_update(&t->root, length, sizeof(length));
+    hmac_final(&t->root, t->key, mac);
+}
+
+/* The single tag at the end of format 3 or 6. */
+struct trailer {
+    SHA256_CTX hmac;    /* format 3 */
+    struct tree tree;   /* format 6 */
+    const uint8_t *key;
+    int version;
+};
+
+static void
+trailer_init(struct trailer *t, const uint8_t *key, int version)
+{
+    t->key = key;
+    t->version = version;
+    if (version == 6)
+        tree_init(&t->tree, key);
+    else
+        hmac_init(&t->hmac, key);
+}
+
+/**
+ * Run the cipher over LEN bytes from IN to OUT, encrypting unless
+ * DECRYPT, and feed the right side of it into the tag.
+ */
+static void
+trailer_crypt(struct trailer *t, chacha_ctx *ctx, int decrypt,
+              const uint8_t *in, uint8_t *out, size_t len)
+{
+    if (t->version == 6) {
+        while (len) {
+            uint32_t z = len < FUSED_CHUNK ? len : FUSED_CHUNK;
+            chacha_encrypt(ctx, in, out, z);
+            tree_update(&t->tree, decrypt ? in : out, z);
+            in += z;
+            out += z;
+            len -= z;
+        }
+    } else if (decrypt) {
+        fused_mac_out(ctx, &t->hmac, in, out, len);
+    } else {
+        fused_mac_in(ctx, &t->hmac, in, out, len);
+    }
+}
+
+static void
+trailer_final(struct trailer *t, uint8_t *mac)
+{
+    if (t->version == 6)
+        tree_final(&t->tree, mac);
+    else
+        hmac_final(&t->hmac, t->key, mac);
+}
+
+/**
+ * Allocate LEN bytes of scratch memory for key derivation, preferring
+ * huge pages to cut TLB misses during the random walk, and prefault
+ * it. Sets *MAPLEN to the length to pass to kdf_free(). Returns NULL
+ * when out of memory.
+ */
+static uint8_t *kdf_alloc(size_t len, size_t *maplen);
+
+/**
+ * Release memory from kdf_alloc().
+ */
+static void kdf_free(uint8_t *p, size_t maplen);
+
+#if defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#include <sys/mman.h>
+
+#ifndef MAP_ANONYMOUS
+#  define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/* Smaller buffers aren't worth a mapping of their own. */
+#define KDF_HUGE_PAGE (1UL << 21)
+
+static uint8_t *
+kdf_alloc(size_t len, size_t *maplen)
+{
+    int prot = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    const char *mode = "mmap";
+    uint8_t *p = MAP_FAILED;
+    size_t i;
+
+    if (len < KDF_HUGE_PAGE) {
+        *maplen = 0;
+        return malloc(len);
+    }
+    len = (len + KDF_HUGE_PAGE - 1) & ~(KDF_HUGE_PAGE - 1);
+
+#ifdef MAP_HUGETLB
+    /* Explicit huge pages only exist if the administrator reserved them. */
+    p = mmap(0, len, prot, flags | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED)
+        mode = "hugetlb";
+#endif
+    if (p == MAP_FAILED) {
+        p = mmap(0, len, prot, flags, -1, 0);
+        if (p == MAP_FAILED) {
+            *maplen = 0;
+            info("key derivation memory: malloc");
+            return malloc(len);
+        }
+#ifdef MADV_HUGEPAGE
+        if (!madvise(p, len, MADV_HUGEPAGE))
+            mode = "transparent huge pages";
+#endif
+    }
+
+    /* Fault everything in now rather than during the fill. */
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(p, len, MADV_POPULATE_WRITE))
+#endif
+        for (i = 0; i < len; i += 4096)
+            p[i] = 0;
+
+    info("key derivation memory: %s, %lu MiB", mode, (unsigned long)(len >> 20));
+    *maplen = len;
+    return p;
+}
+
+static void
+kdf_free(uint8_t *p, size_t maplen)
+{
+    if (maplen)
+        munmap(p, maplen);
+    else
+        free(p);
+}
+
+#else
+static uint8_t *
+kdf_alloc(size_t len, size_t *maplen)
+{
+    *maplen = 0;
+    return malloc(len);
+}
+
+static void
+kdf_free(uint8_t *p, size_t maplen)
+{
+    (void)maplen;
+    free(p);
+}
+#endif
+
 /**
  * Derive a 32-byte key from null-terminated passphrase into buf.
  * Optionally provide an 8-byte salt.
@@ -805,8 +1362,9 @@ key_derive(const char *passphrase, uint8_t *buf, int iexp, const uint8_t *salt)
     unsigned long mask = memlen - 1;
     unsigned long iterations = 1UL << (iexp - 5);
     uint8_t *memory, *memptr, *p;
+    size_t maplen;
 
-    memory = malloc(memlen + SHA256_BLOCK_SIZE);
+    memory = kdf_alloc(memlen + SHA256_BLOCK_SIZE, &maplen);
     if (!memory)
         fatal("not enough memory for key derivation");
 
@@ -818,18 +1376,13 @@ key_derive(const char *passphrase, uint8_t *buf, int iexp, const uint8_t *salt)
 
     for (p = memory + SHA256_BLOCK_SIZE;
          p < memory + memlen + SHA256_BLOCK_SIZE;
-         p += SHA256_BLOCK_SIZE) {
-        sha256_init(ctx);
-        sha256_update(ctx, p - SHA256_BLOCK_SIZE, SHA256_BLOCK_SIZE);
-        sha256_final(ctx, p);
-    }
+         p += SHA256_BLOCK_SIZE)
+        sha256_hash32(p, p - SHA256_BLOCK_SIZE);
 
     memptr = memory + memlen - SHA256_BLOCK_SIZE;
     for (i = 0; i < iterations; i++) {
         unsigned long offset;
-        sha256_init(ctx);
-        sha256_update(ctx, memptr, SHA256_BLOCK_SIZE);
-        sha256_final(ctx, memptr);
+        sha256_hash32(memptr, memptr);
         offset = ((unsigned long)memptr[3] << 24 |
                   (unsigned long)memptr[2] << 16 |
                   (unsigned long)memptr[1] <<  8 |
@@ -838,20 +1391,109 @@ key_derive(const char *passphrase, uint8_t *buf, int iexp, const uint8_t *salt)
     }
 
     memcpy(buf, memptr, SHA256_BLOCK_SIZE);
-    free(memory);
+    kdf_free(memory, maplen);
+}
+
+/* Default targets for --iterations=auto and --derive=auto. */
+#define KDF_AUTO_SECONDS 1.0
+#define KDF_AUTO_MEMORY  (1024.0 * 1024 * 1024)
+
+/**
+ * Time a single key_derive() at exponent IEXP in seconds of CPU time.
+ */
+static double
+kdf_time(int iexp)
+{
+    uint8_t key[SHA256_BLOCK_SIZE];
+    clock_t start = clock();
+    key_derive("", key, iexp, 0);
+    return (clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+/**
+ * Find the largest key derivation exponent that costs at most SECONDS
+ * on this host and uses at most MEMORY bytes.
+ *
+ * Cost doubles with each exponent, so this measures increasing sizes
+ * until one run reaches an eighth of the budget, then extrapolates the
+ * rest of the way. Calibration spends about a quarter of the budget.
+ * The chosen exponent and its estimated cost are printed as NAME.
+ */
+static int
+kdf_calibrate(const char *name, double seconds, double memory)
+{
+    int max = 31;
+    int iexp = 5;
+    double t;
+
+    while (max > 5 && (double)(1UL << max) > memory)
+        max--;
+    if ((double)(1UL << max) > memory)
+        fatal("%s memory limit is too small", name);
+
+    t = kdf_time(iexp);
+    while (iexp < max && t < seconds / 8)
+        t = kdf_time(++iexp);
+    while (iexp < max && t * 2 <= seconds) {
+        iexp++;
+        t *= 2;
+    }
+    while (iexp > 5 && t > seconds) {
+        iexp--;
+        t /= 2;
+    }
+
+    if (iexp >= 20)
+        fprintf(stderr, "%s: %d (%lu MiB, about %.2fs on this host)\n",
+                name, iexp, (1UL << iexp) >> 20, t);
+    else
+        fprintf(stderr, "%s: %d (%lu KiB, about %.2fs on this host)\n",
+                name, iexp, (1UL << iexp) >> 10, t);
+    return iexp;
 }
 
 /**
  * Get secure entropy suitable for key generation from OS.
  * Abort the program if the entropy could not be retrieved.
  */
-static void secure_entropy(void *buf, size_t len);
+static void system_entropy(void *buf, size_t len);
+
+/**
+ * Return an identifier for the running process, so that state copied
+ * by fork() can be detected.
+ */
+static long process_id(void);
 
 #if defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
 static void
-secure_entropy(void *buf, size_t len)
+system_entropy(void *buf, size_t len)
 {
-    FILE *r = fopen("/dev/urandom", "rb");
+    FILE *r;
+#ifdef SYS_getrandom
+    /* Needs no file descriptor, and works in a chroot without /dev. */
+    uint8_t *p = buf;
+    while (len) {
+        long z = syscall(SYS_getrandom, p, len, 0);
+        if (z < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENOSYS)
+                break;
+            fatal("failed to gather entropy -- %s", strerror(errno));
+        }
+        p += z;
+        len -= z;
+    }
+    if (!len)
+        return;
+    buf = p;
+#endif
+    r = fopen("/dev/urandom", "rb");
     if (!r)
         fatal("failed to open %s", "/dev/urandom");
     if (!fread(buf, len, 1, r))
@@ -859,11 +1501,17 @@ secure_entropy(void *buf, size_t len)
     fclose(r);
 }
 
+static long
+process_id(void)
+{
+    return getpid();
+}
+
 #elif defined(_WIN32)
 #include <windows.h>
 
 static void
-secure_entropy(void *buf, size_t len)
+system_entropy(void *buf, size_t len)
 {
     HCRYPTPROV h = 0;
     DWORD type = PROV_RSA_FULL;
@@ -873,8 +1521,71 @@ secure_entropy(void *buf, size_t len)
         fatal("failed to gather entropy");
     CryptReleaseContext(h, 0);
 }
+
+static long
+process_id(void)
+{
+    return GetCurrentProcessId();
+}
 #endif
 
+/* State of the random generator behind secure_entropy(). */
+static struct {
+    uint8_t key[32];
+    uint8_t buf[CHACHA_BLOCKLENGTH * 8];
+    size_t avail; /* unused bytes at the end of buf */
+    long pid;     /* process that seeded key, or 0 if not seeded */
+} drbg;
+
+/**
+ * Get secure entropy suitable for key generation.
+ * Abort the program if the entropy could not be retrieved.
+ *
+ * This is a fast-key-erasure generator: the OS seeds a ChaCha20 key
+ * once per process, and each refill of the buffer replaces that key
+ * with the first 32 bytes of its own keystream. Output bytes are wiped
+ * from the buffer as they're handed out, so the state never reveals
+ * past output, and repeated requests cost no system calls.
+ */
+static void
+secure_entropy(void *buf, size_t len)
+{
+    static const uint8_t iv[8] = {0};
+    uint8_t *out = buf;
+
+    if (drbg.pid != process_id()) {
+        /* Never share a stream with a parent or child process. */
+        system_entropy(drbg.key, sizeof(drbg.key));
+        memset(drbg.buf, 0, sizeof(drbg.buf));
+        drbg.avail = 0;
+        drbg.pid = process_id();
+    }
+
+    while (len) {
+        uint8_t *p;
+        size_t z;
+        if (!drbg.avail) {
+            chacha_ctx ctx[1];
+            chacha_keysetup(ctx, drbg.key, 256);
+            chacha_ivsetup(ctx, iv);
+            chacha_rounds(ctx, 20);
+            memset(drbg.buf, 0, sizeof(drbg.buf));
+            chacha_encrypt(ctx, drbg.buf, drbg.buf, sizeof(drbg.buf));
+            memcpy(drbg.key, drbg.buf, sizeof(drbg.key));
+            memset(drbg.buf, 0, sizeof(drbg.key));
+            memset(ctx, 0, sizeof(ctx));
+            drbg.avail = sizeof(drbg.buf) - sizeof(drbg.key);
+        }
+        z = len < drbg.avail ? len : drbg.avail;
+        p = drbg.buf + sizeof(drbg.buf) - drbg.avail;
+        memcpy(out, p, z);
+        memset(p, 0, z);
+        drbg.avail -= z;
+        out += z;
+        len -= z;
+    }
+}
+
 /**
  * Generate a brand new Curve25519 secret key from system entropy.
  */
@@ -893,106 +1604,1693 @@ generate_secret(uint8_t *s)
 static void
 compute_public(uint8_t *p, const uint8_t *s)
 {
-    static const uint8_t b[32] = {9};
-    curve25519_donna(p, s, b);
+    curve25519_donna_base(p, s);
 }
 
+/* Precomputed table for the public key, see load_pubtable(). */
+static uint8_t pubtable[CURVE25519_TABLE_SIZE];
+static uint8_t pubtable_key[32];
+static int pubtable_loaded;
+
 /**
  * Compute a shared secret from our secret key and their public key.
  */
 static void
 compute_shared(uint8_t *sh, const uint8_t *s, const uint8_t *p)
 {
+    if (pubtable_loaded && !memcmp(p, pubtable_key, 32))
+        if (!curve25519_donna_table(sh, s, pubtable))
+            return;
     curve25519_donna(sh, s, p);
 }
 
+/* Default length of the data-path buffers. */
+#define IO_BUFLEN (CHACHA_BLOCKLENGTH * 1024)
+
+/* Most pieces passed to one io_write(). */
+#define IO_MAXVEC 4
+
+/* Returned by io_read() on error. */
+#define IO_ERROR ((size_t)-1)
+
+/* Pipe capacity to ask for, see io_pipe(). */
+#define IO_PIPE_SIZE (1024L * 1024)
+
+/* Buffer length requested with --buffer-size, or 0 for automatic. */
+static size_t io_buflen;
+
+/* Data-path backends, chosen with --io. */
+enum io_backend {
+    IO_STREAM,  /* read() and write() through buffers */
+    IO_SPLICE,  /* like IO_STREAM, but vmsplice() into an output pipe */
+    IO_MMAP,    /* cipher between memory maps of regular files */
+    IO_URING    /* asynchronous reads and writes with io_uring */
+};
+
+static enum io_backend io_backend = IO_STREAM;
+
+/* One piece of a vectored write. */
+struct iobuf {
+    const void *buf;
+    size_t len;
+};
+
+/**
+ * Read up to LEN bytes from F, stopping short only at end of file.
+ * Returns the number of bytes read, or IO_ERROR.
+ */
+static size_t io_read(FILE *f, void *buf, size_t len);
+
+/**
+ * Write N (at most IO_MAXVEC) buffers to F in order, in as few calls
+ * as possible. Returns 0 on success, or -1 on error.
+ */
+static int io_write(FILE *f, const struct iobuf *v, int n);
+
+/**
+ * If F is a regular file with at least LEN bytes left, read its last
+ * LEN bytes into BUF without moving the file position, store the
+ * number of bytes before them in *LEFT, and return 0. Returns 1 if the
+ * length can't be known up front, or -1 on error.
+ */
+static int io_tail(FILE *f, void *buf, size_t len, uint64_t *left);
+
+/**
+ * Advance F past its next LEN bytes, seeking if possible and reading
+ * through them otherwise. Skipping past the end of the file is not an
+ * error. Returns 0 on success, or -1 on error.
+ */
+static int io_skip(FILE *f, uint64_t len);
+
+/**
+ * Return the preferred I/O block size for F, or 0 if unknown.
+ */
+static size_t io_blksize(FILE *f);
+
+/**
+ * If F is a pipe, try to grow it to IO_PIPE_SIZE so that each wakeup
+ * of the other end moves more data. Returns the pipe's capacity, or 0
+ * if F isn't a pipe whose capacity is known.
+ */
+static size_t io_pipe(FILE *f);
+
+/**
+ * Return a fresh page-aligned buffer of LEN bytes for io_give(),
+ * aborting when out of memory.
+ */
+static uint8_t *io_gift_new(size_t len);
+
+/**
+ * Release a LEN-byte buffer from io_gift_new().
+ */
+static void io_gift_free(uint8_t *buf, size_t len);
+
+/**
+ * Write LEN bytes at BUF, inside a buffer from io_gift_new(), to the
+ * pipe F by gifting the pages to the pipe with vmsplice() instead of
+ * copying them. A reader may go on holding those pages long after
+ * this returns, so once any part of a buffer has been given, nothing
+ * in it may be written again: release it with io_gift_free() and
+ * take a fresh one. Returns 0 on success, or -1 on error.
+ */
+static int io_give(FILE *f, const void *buf, size_t len);
+
+#if ENCHIVE_OPTION_RAWIO
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+static size_t
+io_read(FILE *f, void *buf, size_t len)
+{
+    int fd = fileno(f);
+    size_t n = 0;
+    while (n < len) {
+        ssize_t z = read(fd, (char *)buf + n, len - n);
+        if (z < 0) {
+            if (errno == EINTR)
+                continue;
+            return IO_ERROR;
+        }
+        if (!z)
+            break;
+        n += z;
+    }
+    return n;
+}
+
+static int
+io_write(FILE *f, const struct iobuf *v, int n)
+{
+    struct iovec iov[IO_MAXVEC];
+    int fd = fileno(f);
+    int i;
+    int c = 0;
+
+    for (i = 0; i < n; i++) {
+        if (v[i].len) {
+            iov[c].iov_base = (void *)v[i].buf;
+            iov[c].iov_len = v[i].len;
+            c++;
+        }
+    }
+
+    i = 0;
+    while (i < c) {
+        ssize_t z = writev(fd, iov + i, c - i);
+        if (z < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        /* Skip past whatever was written, resuming a partial piece. */
+        while (i < c && (size_t)z >= iov[i].iov_len)
+            z -= iov[i++].iov_len;
+        if (i < c) {
+            iov[i].iov_base = (char *)iov[i].iov_base + z;
+            iov[i].iov_len -= z;
+        }
+    }
+    return 0;
+}
+
+static int
+io_tail(FILE *f, void *buf, size_t len, uint64_t *left)
+{
+    struct stat st;
+    int fd = fileno(f);
+    off_t pos;
+    size_t n = 0;
+
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode))
+        return 1;
+    pos = lseek(fd, 0, SEEK_CUR);
+    if (pos < 0 || st.st_size < pos || (uint64_t)(st.st_size - pos) < len)
+        return 1;
+
+    while (n < len) {
+        ssize_t z = pread(fd, (char *)buf + n, len - n,
+                          st.st_size - len + n);
+        if (z < 0 && errno == EINTR)
+            continue;
+        if (z <= 0)
+            return -1;
+        n += z;
+    }
+    *left = st.st_size - pos - len;
+    return 0;
+}
+
+static int
+io_skip(FILE *f, uint64_t len)
+{
+    char scratch[4096];
+    int fd = fileno(f);
+
+    while (len) {
+        /* Small steps, in case off_t is only 32 bits. */
+        off_t step = len < 0x40000000 ? (off_t)len : 0x40000000;
+        if (lseek(fd, step, SEEK_CUR) < 0) {
+            if (errno != ESPIPE)
+                return -1;
+            break;
+        }
+        len -= step;
+    }
+
+    while (len) {
+        size_t z = len < sizeof(scratch) ? len : sizeof(scratch);
+        z = io_read(f, scratch, z);
+        if (z == IO_ERROR)
+            return -1;
+        if (!z)
+            break;
+        len -= z;
+    }
+    return 0;
+}
+
+static size_t
+io_blksize(FILE *f)
+{
+    struct stat st;
+    if (fstat(fileno(f), &st) || st.st_blksize <= 0)
+        return 0;
+    return st.st_blksize;
+}
+
+static size_t
+io_pipe(FILE *f)
+{
+#ifdef F_SETPIPE_SZ
+    struct stat st;
+    int fd = fileno(f);
+    int size;
+    if (fstat(fd, &st) || !S_ISFIFO(st.st_mode))
+        return 0;
+    /* Unprivileged users may be capped lower, so keep what's there. */
+    fcntl(fd, F_SETPIPE_SZ, IO_PIPE_SIZE);
+    size = fcntl(fd, F_GETPIPE_SZ);
+    return size > 0 ? size : 0;
+#else
+    (void)f;
+    return 0;
+#endif
+}
+
+static uint8_t *
+io_gift_new(size_t len)
+{
+    void *p = mmap(0, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        fatal("out of memory");
+    return p;
+}
+
+static void
+io_gift_free(uint8_t *buf, size_t len)
+{
+    /* The pipe keeps its own references to any pages it still holds. */
+    munmap(buf, len);
+}
+
+static int
+io_give(FILE *f, const void *buf, size_t len)
+{
+#ifdef F_SETPIPE_SZ
+    struct iovec iov;
+    int fd = fileno(f);
+    iov.iov_base = (void *)buf;
+    iov.iov_len = len;
+    while (iov.iov_len) {
+        ssize_t z = vmsplice(fd, &iov, 1, SPLICE_F_GIFT);
+        if (z < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        iov.iov_base = (char *)iov.iov_base + z;
+        iov.iov_len -= z;
+    }
+    return 0;
+#else
+    struct iobuf v[1];
+    v[0].buf = buf;
+    v[0].len = len;
+    return io_write(f, v, 1);
+#endif
+}
+
+#else
+static size_t
+io_read(FILE *f, void *buf, size_t len)
+{
+    size_t z = fread(buf, 1, len, f);
+    if (z < len && ferror(f))
+        return IO_ERROR;
+    return z;
+}
+
+static int
+io_write(FILE *f, const struct iobuf *v, int n)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        if (v[i].len && !fwrite(v[i].buf, v[i].len, 1, f))
+            return -1;
+    return 0;
+}
+
+static int
+io_tail(FILE *f, void *buf, size_t len, uint64_t *left)
+{
+    (void)f;
+    (void)buf;
+    (void)len;
+    (void)left;
+    return 1;
+}
+
+static int
+io_skip(FILE *f, uint64_t len)
+{
+    char scratch[4096];
+
+    while (len) {
+        long step = len < 0x40000000 ? (long)len : 0x40000000;
+        if (fseek(f, step, SEEK_CUR))
+            break;
+        len -= step;
+    }
+
+    while (len) {
+        size_t z = len < sizeof(scratch) ? len : sizeof(scratch);
+        z = io_read(f, scratch, z);
+        if (z == IO_ERROR)
+            return -1;
+        if (!z)
+            break;
+        len -= z;
+    }
+    return 0;
+}
+
+static size_t
+io_blksize(FILE *f)
+{
+    (void)f;
+    return 0;
+}
+
+static size_t
+io_pipe(FILE *f)
+{
+    (void)f;
+    return 0;
+}
+
+static uint8_t *
+io_gift_new(size_t len)
+{
+    uint8_t *p = malloc(len);
+    if (!p)
+        fatal("out of memory");
+    return p;
+}
+
+static void
+io_gift_free(uint8_t *buf, size_t len)
+{
+    (void)len;
+    free(buf);
+}
+
+static int
+io_give(FILE *f, const void *buf, size_t len)
+{
+    struct iobuf v[1];
+    v[0].buf = buf;
+    v[0].len = len;
+    return io_write(f, v, 1);
+}
+#endif /* ENCHIVE_OPTION_RAWIO */
+
+/**
+ * Return the data-path buffer length for copying IN to OUT: the
+ * --buffer-size setting, or else IO_BUFLEN rounded up to a whole
+ * number of blocks for either file. Always a multiple of
+ * CHACHA_BLOCKLENGTH, which keeps the keystream in step.
+ */
+static size_t
+io_bufsize(FILE *in, FILE *out)
+{
+    size_t len = io_buflen;
+    if (!len) {
+        size_t a = io_blksize(in);
+        size_t b = io_blksize(out);
+        size_t blk = a > b ? a : b;
+        len = IO_BUFLEN;
+        if (blk && blk <= IO_BUFLEN * 1024)
+            len = (len + blk - 1) / blk * blk;
+    }
+    return (len + CHACHA_BLOCKLENGTH - 1) & ~(size_t)(CHACHA_BLOCKLENGTH - 1);
+}
+
+/**
+ * Return whether the streaming path should hand its output to OUT
+ * with io_give(), in a fresh buffer from io_gift_new() each time:
+ * under --io splice when OUT is a pipe.
+ */
+static int
+io_giving(FILE *out)
+{
+    return io_backend == IO_SPLICE && io_pipe(out);
+}
+
+/**
+ * Write LEN bytes at BUF to F, through io_give() if GIVE.
+ */
+static int
+io_put(FILE *f, const uint8_t *buf, size_t len, int give)
+{
+    struct iobuf v[1];
+    if (give)
+        return io_give(f, buf, len);
+    v[0].buf = buf;
+    v[0].len = len;
+    return io_write(f, v, 1);
+}
+
+/**
+ * Encrypt from file to file in format VERSION, 3 or 6, using key/iv,
+ * aborting on any error.
+ */
+static void
+symmetric_encrypt(FILE *in, FILE *out, const uint8_t *key,
+                  const uint8_t *iv, int version)
+{
+    size_t len = io_bufsize(in, out);
+    int give = io_giving(out);
+    uint8_t *buffer = malloc(len * 2);
+    uint8_t mac[SHA256_BLOCK_SIZE];
+    struct trailer trailer[1];
+    chacha_ctx ctx[1];
+
+    if (!buffer)
+        fatal("out of memory");
+    cipher_init(ctx, key, iv, version);
+    trailer_init(trailer, key, version);
+
+    for (;;) {
+        uint8_t *ct = give ? io_gift_new(len) : buffer + len;
+        struct iobuf v[2];
+        size_t z = io_read(in, buffer, len);
+        if (z == IO_ERROR)
+            fatal("error reading plaintext file");
+        trailer_crypt(trailer, ctx, 0, buffer, ct, z);
+        v[0].buf = ct;
+        v[0].len = z;
+        v[1].buf = mac;
+        v[1].len = 0;
+        if (z < len) {
+            /* Send the last piece of ciphertext and the MAC together. */
+            trailer_final(trailer, mac);
+            v[1].len = sizeof(mac);
+        }
+        if (give) {
+            /* Only the ciphertext pages are worth splicing. */
+            if (io_give(out, ct, z) || io_write(out, v + 1, 1))
+                fatal("error writing ciphertext file");
+            io_gift_free(ct, len);
+        } else if (io_write(out, v, 2)) {
+            fatal("error writing ciphertext file");
+        }
+        if (z < len)
+            break;
+    }
+
+    if (fflush(out))
+        fatal("error flushing to ciphertext file -- %s", strerror(errno));
+    free(buffer);
+}
+
+/**
+ * Decrypt from file to file in format VERSION, 3 or 6, using key/iv,
+ * aborting on any error.
+ */
+static void
+symmetric_decrypt(FILE *in, FILE *out, const uint8_t *key,
+                  const uint8_t *iv, int version)
+{
+    size_t len = io_bufsize(in, out);
+    int give = io_giving(out);
+    uint8_t *buffer = malloc(len * 2 + SHA256_BLOCK_SIZE);
+    uint8_t *plain;
+    uint8_t mac[SHA256_BLOCK_SIZE];
+    uint8_t tail[SHA256_BLOCK_SIZE];
+    uint64_t left;
+    struct trailer trailer[1];
+    chacha_ctx ctx[1];
+
+    if (!buffer)
+        fatal("out of memory");
+    cipher_init(ctx, key, iv, version);
+    trailer_init(trailer, key, version);
+
+    switch (io_tail(in, tail, sizeof(tail), &left)) {
+        case -1:
+            fatal("cannot read ciphertext file");
+            break;
+        case 0:
+            /* The MAC is already in hand, so read exactly the rest. */
+            while (left) {
+                size_t z = left < len ? left : len;
+                plain = give ? io_gift_new(len)
+                             : buffer + SHA256_BLOCK_SIZE + len;
+                if (io_read(in, buffer, z) != z)
+                    fatal("error reading ciphertext file");
+                trailer_crypt(trailer, ctx, 1, buffer, plain, z);
+                if (io_put(out, plain, z, give))
+                    fatal("error writing plaintext file");
+                if (give)
+                    io_gift_free(plain, len);
+                left -= z;
+            }
+            break;
+        case 1:
+            /* Always keep SHA256_BLOCK_SIZE bytes in the buffer. */
+            switch (io_read(in, buffer, SHA256_BLOCK_SIZE)) {
+                case SHA256_BLOCK_SIZE:
+                    break;
+                case IO_ERROR:
+                    fatal("cannot read ciphertext file");
+                    break;
+                default:
+                    fatal("ciphertext file too short");
+            }
+            for (;;) {
+                size_t z = io_read(in, buffer + SHA256_BLOCK_SIZE, len);
+                plain = give ? io_gift_new(len)
+                             : buffer + SHA256_BLOCK_SIZE + len;
+                if (z == IO_ERROR)
+                    fatal("error reading ciphertext file");
+                trailer_crypt(trailer, ctx, 1, buffer, plain, z);
+                if (io_put(out, plain, z, give))
+                    fatal("error writing plaintext file");
+                if (give)
+                    io_gift_free(plain, len);
+
+                /* Move last SHA256_BLOCK_SIZE bytes to the front. */
+                memmove(buffer, buffer + z, SHA256_BLOCK_SIZE);
+
+                if (z < len)
+                    break;
+            }
+            memcpy(tail, buffer, sizeof(tail));
+    }
+
+    trailer_final(trailer, mac);
+    if (memcmp(tail, mac, sizeof(mac)) != 0)
+        fatal("checksum mismatch!");
+    if (fflush(out))
+        fatal("error flushing to plaintext file -- %s", strerror(errno));
+    free(buffer);
+}
+
+/**
+ * Return how many segments to move per read for copying IN to OUT.
+ */
+static size_t
+segment_batch(FILE *in, FILE *out)
+{
+    size_t n = io_bufsize(in, out) / SEGMENT_SIZE;
+    return n ? n : 1;
+}
+
+/**
+ * Encrypt (DECRYPT = 0) or decrypt segmented format VERSION from file
+ * to file using key/iv, aborting on any error. A bad segment aborts
+ * decryption after writing out everything before it.
+ */
+static void
+segment_stream(FILE *in, FILE *out, const uint8_t *key,
+               const uint8_t *iv, int decrypt, int version)
+{
+    size_t batch = segment_batch(in, out);
+    size_t record = SEGMENT_SIZE + segment_tag(version);
+    size_t inlen = batch * (decrypt ? record : SEGMENT_SIZE);
+    size_t outlen = batch * (decrypt ? SEGMENT_SIZE : record);
+    int give = io_giving(out);
+    uint64_t index = 0;
+    uint8_t *buffer = malloc(inlen + outlen);
+    chacha_ctx ctx[1];
+
+    if (!buffer)
+        fatal("out of memory");
+    cipher_init(ctx, key, iv, version);
+
+    for (;;) {
+        uint8_t *dst = give ? io_gift_new(outlen) : buffer + inlen;
+        size_t z = io_read(in, buffer, inlen);
+        size_t w;
+        int bad;
+        if (z == IO_ERROR)
+            fatal("error reading %s file",
+                  decrypt ? "ciphertext" : "plaintext");
+        w = segment_crypt(key, ctx, version, index, decrypt, z < inlen,
+                          buffer, dst, z, &bad);
+        if (io_put(out, dst, w, give))
+            fatal("error writing %s file",
+                  decrypt ? "plaintext" : "ciphertext");
+        if (give)
+            io_gift_free(dst, outlen);
+        if (bad)
+            fatal("checksum mismatch!");
+        if (z < inlen)
+            break;
+        index += batch;
+    }
+
+    if (fflush(out))
+        fatal("error flushing to %s file -- %s",
+              decrypt ? "plaintext" : "ciphertext", strerror(errno));
+    free(buffer);
+}
+
+/* Length for segment_range() meaning "through the end". */
+#define RANGE_ALL ((uint64_t)-1)
+
+/**
+ * Decrypt LENGTH plaintext bytes starting at OFFSET from segmented
+ * format VERSION at IN, positioned just past the header, to OUT using
+ * key/iv. Only the segments covering the range are read and
+ * authenticated, and the range stops early at the end of the
+ * plaintext. Aborts on any error, including an OFFSET past the end
+ * of the plaintext.
+ */
+static void
+segment_range(FILE *in, FILE *out, const uint8_t *key, const uint8_t *iv,
+              int version, uint64_t offset, uint64_t length)
+{
+    size_t batch = segment_batch(in, out);
+    size_t record = SEGMENT_SIZE + segment_tag(version);
+    size_t inlen = batch * record;
+    size_t outlen = batch * SEGMENT_SIZE;
+    int give;
+    uint64_t index = offset / SEGMENT_SIZE;
+    size_t skip = offset % SEGMENT_SIZE;
+    uint8_t *buffer;
+    chacha_ctx ctx[1];
+
+    io_pipe(out);
+    give = io_giving(out);
+    buffer = malloc(inlen + outlen);
+    if (!buffer)
+        fatal("out of memory");
+    cipher_init(ctx, key, iv, version);
+
+    if (io_skip(in, index * record))
+        fatal("error seeking ciphertext file -- %s", strerror(errno));
+
+    for (;;) {
+        uint8_t *dst = give ? io_gift_new(outlen) : buffer + inlen;
+        size_t want = batch;
+        size_t z, w;
+        int bad;
+
+        /* Read no further than the last segment of the range, but
+         * always read the first so that OFFSET gets checked. */
+        if (length < outlen)
+            want = (skip + length + SEGMENT_SIZE - 1) / SEGMENT_SIZE;
+        if (want > batch)
+            want = batch;
+        if (!want)
+            want = 1;
+        want *= record;
+
+        z = io_read(in, buffer, want);
+        if (z == IO_ERROR)
+            fatal("error reading ciphertext file");
+        if (!z && index == offset / SEGMENT_SIZE)
+            fatal("--offset is past the end of the archive");
+        w = segment_crypt(key, ctx, version, index, 1, z < want,
+                          buffer, dst, z, &bad);
+
+        if (w > skip) {
+            size_t put = w - skip;
+            if (put > length)
+                put = length;
+            if (io_put(out, dst + skip, put, give))
+                fatal("error writing plaintext file");
+            length -= put;
+            skip = 0;
+        } else {
+            skip -= w;
+        }
+        if (give)
+            io_gift_free(dst, outlen);
+        if (bad)
+            fatal("checksum mismatch!");
+        if (z < want && skip)
+            fatal("--offset is past the end of the archive");
+        if (z < want || !length)
+            break;
+        index += want / record;
+    }
+
+    if (fflush(out))
+        fatal("error flushing to plaintext file -- %s", strerror(errno));
+    free(buffer);
+}
+
+/**
+ * Encrypt (DECRYPT = 0) or decrypt format VERSION from file to file
+ * using key/iv and JOBS cipher threads, producing exactly the output
+ * of symmetric_encrypt() or symmetric_decrypt() for format 3, or of
+ * segment_stream() otherwise. Aborts on any error.
+ */
+static void symmetric_pipeline(FILE *in, FILE *out, const uint8_t *key,
+                               const uint8_t *iv, int decrypt,
+                               int version, int jobs);
+
+#if ENCHIVE_OPTION_THREADS
+#include <pthread.h>
+
+/* The pipeline moves fixed-size chunks through a ring of slots:
+ *
+ *   reader -> cipher workers (any order) -> writer
+ *          \-> HMAC (in order, on the calling thread)
+ *
+ * Chunk i is enciphered with the keystream starting at block
+ * i * chunk / CHACHA_BLOCKLENGTH, so workers need no coordination. A
+ * slot is reused once its chunk is both written and fed to HMAC,
+ * which bounds memory use. A single lock and condition variable
+ * suffice at this chunk size.
+ *
+ * In formats 4 and 5, chunks are whole segments, which carry their
+ * own tags, so the workers authenticate them too and the HMAC stage
+ * is skipped. In format 6, chunks are whole tree leaves, which the
+ * workers tag, leaving the HMAC stage only the root to compute.
+ */
+struct pipe_slot {
+    uint8_t *in;    /* inlen + SHA256_BLOCK_SIZE bytes */
+    uint8_t *out;   /* outlen bytes */
+    uint8_t *tags;  /* leaf tags, for format 6 */
+    size_t ntags;
+    size_t len;
+    size_t outlen;  /* bytes of output, once crypted */
+    int crypted;
+    int bad;        /* a segment failed authentication */
+};
+
+struct pipeline {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct pipe_slot *slots;
+    unsigned long nslots;
+    size_t inlen;   /* input bytes per chunk */
+    size_t outlen;  /* output bytes per chunk */
+    size_t batch;   /* segments per chunk, or 0 for formats 3 and 6 */
+    size_t leaves;  /* tree leaves per chunk, or 0 but for format 6 */
+    int version;
+    int decrypt;
+    FILE *in;
+    FILE *out;
+    const uint8_t *key;
+    chacha_ctx ctx;
+    /* Next chunk for each stage, and one past the last chunk. */
+    unsigned long nread;
+    unsigned long ncrypt;
+    unsigned long nmac;
+    unsigned long nwrite;
+    unsigned long end;
+    uint8_t mac[SHA256_BLOCK_SIZE]; /* trailing MAC when decrypting */
+};
+
+static void
+pipe_lock(struct pipeline *p)
+{
+    if (pthread_mutex_lock(&p->lock))
+        fatal("pthread_mutex_lock() failed");
+}
+
+static void
+pipe_unlock(struct pipeline *p)
+{
+    pthread_mutex_unlock(&p->lock);
+}
+
+/**
+ * Wake all stages after a change and release the lock.
+ */
+static void
+pipe_signal(struct pipeline *p)
+{
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void
+pipe_wait(struct pipeline *p)
+{
+    if (pthread_cond_wait(&p->cond, &p->lock))
+        fatal("pthread_cond_wait() failed");
+}
+
+static void *
+pipe_reader(void *arg)
+{
+    struct pipeline *p = arg;
+    uint8_t carry[SHA256_BLOCK_SIZE];
+    int hold = p->decrypt && !p->batch;
+    unsigned long i;
+
+    /* Always hold back SHA256_BLOCK_SIZE bytes when decrypting. */
+    if (hold) {
+        switch (io_read(p->in, carry, sizeof(carry))) {
+            case sizeof(carry):
+                break;
+            case IO_ERROR:
+                fatal("cannot read ciphertext file");
+                break;
+            default:
+                fatal("ciphertext file too short");
+        }
+    }
+
+    for (i = 0; ; i++) {
+        struct pipe_slot *s = p->slots + i % p->nslots;
+        size_t z;
+
+        pipe_lock(p);
+        while (i - (p->nmac < p->nwrite ? p->nmac : p->nwrite) >= p->nslots)
+            pipe_wait(p);
+        pipe_unlock(p);
+
+        if (hold) {
+            memcpy(s->in, carry, sizeof(carry));
+            z = io_read(p->in, s->in + sizeof(carry), p->inlen);
+            if (z != IO_ERROR)
+                memcpy(carry, s->in + z, sizeof(carry));
+        } else {
+            z = io_read(p->in, s->in, p->inlen);
+        }
+        if (z == IO_ERROR)
+            fatal("error reading %s file",
+                  p->decrypt ? "ciphertext" : "plaintext");
+        pipe_lock(p);
+        s->len = z;
+        s->crypted = 0;
+        p->nread = i + 1;
+        if (z < p->inlen) {
+            p->end = i + 1;
+            if (hold)
+                memcpy(p->mac, carry, sizeof(carry));
+        }
+        pipe_signal(p);
+        if (z < p->inlen)
+            return 0;
+    }
+}
+
+static void *
+pipe_worker(void *arg)
+{
+    struct pipeline *p = arg;
+    chacha_ctx ctx[1];
+
+    *ctx = p->ctx;
+    for (;;) {
+        unsigned long i;
+        struct pipe_slot *s;
+
+        pipe_lock(p);
+        while (p->ncrypt == p->nread && p->ncrypt != p->end)
+            pipe_wait(p);
+        if (p->ncrypt == p->end) {
+            pipe_unlock(p);
+            return 0;
+        }
+        i = p->ncrypt++;
+        pipe_unlock(p);
+
+        s = p->slots + i % p->nslots;
+        s->bad = 0;
+        if (p->batch) {
+            s->outlen = segment_crypt(p->key, ctx, p->version,
+                                      (uint64_t)i * p->batch, p->decrypt,
+                                      s->len < p->inlen,
+                                      s->in, s->out, s->len, &s->bad);
+        } else {
+            chacha_seek(ctx,
+                        (uint64_t)i * (p->inlen / CHACHA_BLOCKLENGTH));
+            chacha_encrypt(ctx, s->in, s->out, s->len);
+            s->outlen = s->len;
+            if (p->leaves)
+                s->ntags = tree_leaves(p->key, (uint64_t)i * p->leaves,
+                                       s->len < p->inlen,
+                                       p->decrypt ? s->in : s->out,
+                                       s->len, s->tags);
+        }
+
+        pipe_lock(p);
+        s->crypted = 1;
+        pipe_signal(p);
+    }
+}
+
+static void *
+pipe_writer(void *arg)
+{
+    struct pipeline *p = arg;
+    unsigned long i;
+
+    for (i = 0; ; i++) {
+        struct pipe_slot *s = p->slots + i % p->nslots;
+        struct iobuf v[1];
+
+        pipe_lock(p);
+        while (i != p->end && (i >= p->nread || !s->crypted))
+            pipe_wait(p);
+        pipe_unlock(p);
+        if (i == p->end)
+            return 0;
+
+        v[0].buf = s->out;
+        v[0].len = s->outlen;
+        if (io_write(p->out, v, 1))
+            fatal("error writing %s file",
+                  p->decrypt ? "plaintext" : "ciphertext");
+        if (s->bad)
+            fatal("checksum mismatch!");
+
+        pipe_lock(p);
+        p->nwrite = i + 1;
+        pipe_signal(p);
+    }
+}
+
+static void
+symmetric_pipeline(FILE *in, FILE *out, const uint8_t *key,
+                   const uint8_t *iv, int decrypt, int version, int jobs)
+{
+    struct pipeline p[1];
+    pthread_t reader, writer, *workers;
+    uint8_t mac[SHA256_BLOCK_SIZE];
+    struct trailer trailer[1];
+    size_t record = SEGMENT_SIZE + segment_tag(version);
+    int segmented = segment_tag(version) != 0;
+    unsigned long i;
+    int j;
+
+    memset(p, 0, sizeof(*p));
+    p->version = version;
+    p->decrypt = decrypt;
+    p->in = in;
+    p->out = out;
+    p->key = key;
+    p->end = (unsigned long)-1;
+    p->nslots = 2UL * jobs + 4;
+    if (segmented) {
+        p->batch = segment_batch(in, out);
+        p->inlen = p->batch * (decrypt ? record : SEGMENT_SIZE);
+        p->outlen = p->batch * (decrypt ? SEGMENT_SIZE : record);
+    } else if (version == 6) {
+        p->leaves = segment_batch(in, out);
+        p->inlen = p->outlen = p->leaves * TREE_LEAF;
+    } else {
+        p->inlen = p->outlen = io_bufsize(in, out);
+    }
+    cipher_init(&p->ctx, key, iv, version);
+
+    p->slots = calloc(p->nslots, sizeof(*p->slots));
+    workers = malloc(jobs * sizeof(*workers));
+    if (!p->slots || !workers)
+        fatal("out of memory");
+    for (i = 0; i < p->nslots; i++) {
+        p->slots[i].in = malloc(p->inlen + SHA256_BLOCK_SIZE);
+        p->slots[i].out = malloc(p->outlen);
+        p->slots[i].tags = malloc((p->leaves + 1) * SHA256_BLOCK_SIZE);
+        if (!p->slots[i].in || !p->slots[i].out || !p->slots[i].tags)
+            fatal("out of memory");
+    }
+
+    if (pthread_mutex_init(&p->lock, 0) || pthread_cond_init(&p->cond, 0))
+        fatal("could not initialize pipeline");
+    if (segmented)
+        p->nmac = (unsigned long)-1; /* no HMAC stage to wait on */
+    if (pthread_create(&reader, 0, pipe_reader, p) ||
+        pthread_create(&writer, 0, pipe_writer, p))
+        fatal("could not start pipeline thread");
+    for (j = 0; j < jobs; j++)
+        if (pthread_create(workers + j, 0, pipe_worker, p))
+            fatal("could not start pipeline thread");
+
+    /* The HMAC stage runs here, strictly in chunk order. */
+    trailer_init(trailer, key, version);
+    for (i = 0; !segmented; i++) {
+        struct pipe_slot *s = p->slots + i % p->nslots;
+        int wait = decrypt || p->leaves;
+        size_t k;
+
+        pipe_lock(p);
+        while (i != p->end && (i >= p->nread || (wait && !s->crypted)))
+            pipe_wait(p);
+        pipe_unlock(p);
+        if (i == p->end)
+            break;
+
+        if (!p->leaves)
+            sha256_update(&trailer->hmac, decrypt ? s->out : s->in, s->len);
+        for (k = 0; k < s->ntags; k++) {
+            size_t z = s->len - k * TREE_LEAF;
+            tree_add(&trailer->tree, s->tags + k * SHA256_BLOCK_SIZE,
+                     z < TREE_LEAF ? z : TREE_LEAF);
+        }
+
+        pipe_lock(p);
+        p->nmac = i + 1;
+        pipe_signal(p);
+    }
+    trailer_final(trailer, mac);
+
+    pthread_join(reader, 0);
+    pthread_join(writer, 0);
+    for (j = 0; j < jobs; j++)
+        pthread_join(workers[j], 0);
+
+    if (segmented) {
+        if (fflush(out))
+            fatal("error flushing to %s file -- %s",
+                  decrypt ? "plaintext" : "ciphertext", strerror(errno));
+    } else if (decrypt) {
+        if (memcmp(p->mac, mac, sizeof(mac)) != 0)
+            fatal("checksum mismatch!");
+        if (fflush(out))
+            fatal("error flushing to plaintext file -- %s", strerror(errno));
+    } else {
+        struct iobuf v[1];
+        v[0].buf = mac;
+        v[0].len = sizeof(mac);
+        if (io_write(out, v, 1))
+            fatal("error writing checksum to ciphertext file");
+        if (fflush(out))
+            fatal("error flushing to ciphertext file -- %s", strerror(errno));
+    }
+
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+    for (i = 0; i < p->nslots; i++) {
+        free(p->slots[i].in);
+        free(p->slots[i].out);
+        free(p->slots[i].tags);
+    }
+    free(p->slots);
+    free(workers);
+}
+
+#else
+static void
+symmetric_pipeline(FILE *in, FILE *out, const uint8_t *key,
+                   const uint8_t *iv, int decrypt, int version, int jobs)
+{
+    (void)jobs;
+    if (segment_tag(version))
+        segment_stream(in, out, key, iv, decrypt, version);
+    else if (decrypt)
+        symmetric_decrypt(in, out, key, iv, version);
+    else
+        symmetric_encrypt(in, out, key, iv, version);
+}
+#endif /* ENCHIVE_OPTION_THREADS */
+
+/**
+ * Encrypt (DECRYPT = 0) or decrypt between regular files IN and OUT
+ * through memory maps, so the cipher reads the source pages and
+ * writes the destination pages directly. Returns 0 when done, or 1
+ * if the files can't be mapped, in which case nothing has been
+ * changed and the caller should stream instead. Aborts on any error.
+ */
+static int symmetric_mapped(FILE *in, FILE *out, const uint8_t *key,
+                            const uint8_t *iv, int decrypt, int version);
+
+#if ENCHIVE_OPTION_RAWIO
+#include <sys/mman.h>
+
+/**
+ * Map LEN bytes of FD from OFFSET, which need not be page aligned.
+ * Returns a pointer to OFFSET and fills in *BASE and *MAPLEN for
+ * munmap(), or returns NULL on failure.
+ */
+static uint8_t *
+io_map(int fd, uint64_t offset, size_t len, int prot,
+       void **base, size_t *maplen)
+{
+    uint64_t page = sysconf(_SC_PAGESIZE);
+    uint64_t start = offset - offset % page;
+    void *p;
+
+    *maplen = offset - start + len;
+    p = mmap(0, *maplen, prot, MAP_SHARED, fd, start);
+    if (p == MAP_FAILED)
+        return 0;
+#ifdef MADV_SEQUENTIAL
+    madvise(p, *maplen, MADV_SEQUENTIAL);
+#endif
+    *base = p;
+    return (uint8_t *)p + (offset - start);
+}
+
+/**
+ * Grow FD to hold LEN bytes from OFFSET, reserving the disk space up
+ * front where the file system allows it. Stores through a map past
+ * the end of the disk would otherwise kill the process with SIGBUS.
+ */
+static int
+io_reserve(int fd, off_t offset, off_t len)
+{
+#ifdef __linux__
+    if (!fallocate(fd, 0, offset, len))
+        return 0;
+    if (errno != EOPNOTSUPP && errno != ENOSYS)
+        return -1;
+#endif
+    return ftruncate(fd, offset + len);
+}
+
+static int
+symmetric_mapped(FILE *in, FILE *out, const uint8_t *key,
+                 const uint8_t *iv, int decrypt, int version)
+{
+    size_t taglen = segment_tag(version);
+    size_t record = SEGMENT_SIZE + taglen;
+    int segmented = segment_tag(version) != 0;
+    int ifd = fileno(in);
+    int ofd = fileno(out);
+    struct stat ist, ost;
+    off_t ipos, opos;
+    uint64_t ilen, olen;
+    void *ibase, *obase;
+    size_t imaplen, omaplen;
+    uint8_t *src, *dst;
+    uint8_t mac[SHA256_BLOCK_SIZE];
+    struct trailer trailer[1];
+    chacha_ctx ctx[1];
+
+    if (fstat(ifd, &ist) || !S_ISREG(ist.st_mode) ||
+        fstat(ofd, &ost) || !S_ISREG(ost.st_mode))
+        return 1;
+    ipos = lseek(ifd, 0, SEEK_CUR);
+    opos = lseek(ofd, 0, SEEK_CUR);
+    if (ipos < 0 || opos < 0 || ist.st_size < ipos)
+        return 1;
+
+    /* Empty and truncated inputs are left to the streaming path. */
+    ilen = ist.st_size - ipos;
+    if (segmented && decrypt) {
+        uint64_t tail = ilen % record;
+        if (tail < taglen || ilen == taglen)
+            return 1;
+        olen = ilen - (ilen / record + 1) * taglen;
+    } else if (segmented) {
+        if (!ilen)
+            return 1;
+        olen = ilen + (ilen / SEGMENT_SIZE + 1) * taglen;
+    } else if (decrypt) {
+        if (ilen <= SHA256_BLOCK_SIZE)
+            return 1;
+        olen = ilen - SHA256_BLOCK_SIZE;
+    } else {
+        if (!ilen)
+            return 1;
+        olen = ilen + SHA256_BLOCK_SIZE;
+    }
+    if ((size_t)ilen != ilen || (size_t)olen != olen)
+        return 1;
+
+    /* The output map fails here, harmlessly, if OUT is write-only. */
+    src = io_map(ifd, ipos, ilen, PROT_READ, &ibase, &imaplen);
+    if (!src)
+        return 1;
+    dst = io_map(ofd, opos, olen, PROT_READ | PROT_WRITE, &obase, &omaplen);
+    if (!dst) {
+        munmap(ibase, imaplen);
+        return 1;
+    }
+    if (io_reserve(ofd, opos, olen))
+        fatal("error writing %s file -- %s",
+              decrypt ? "plaintext" : "ciphertext", strerror(errno));
+
+    cipher_init(ctx, key, iv, version);
+    trailer_init(trailer, key, version);
+    if (segmented && decrypt) {
+        /* Decipher each segment into a scratch buffer, so that only
+         * authenticated plaintext ever reaches the output map. */
+        uint8_t *scratch = malloc(SEGMENT_SIZE);
+        uint64_t index = 0;
+        uint64_t done = 0;
+        if (!scratch)
+            fatal("out of memory");
+        for (;;) {
+            uint64_t ioff = index * record;
+            int final = ilen - ioff < record;
+            size_t z = final ? ilen - ioff : record;
+            size_t n;
+            int bad;
+            n = segment_crypt(key, ctx, version, index, 1, final,
+                              src + ioff, scratch, z, &bad);
+            if (bad) {
+                munmap(ibase, imaplen);
+                munmap(obase, omaplen);
+                if (ftruncate(ofd, opos + done))
+                    fatal("error truncating plaintext file -- %s",
+                          strerror(errno));
+                fatal("checksum mismatch!");
+            }
+            memcpy(dst + done, scratch, n);
+            done += n;
+            index++;
+            if (final)
+                break;
+        }
+        free(scratch);
+    } else if (segmented) {
+        int bad;
+        segment_crypt(key, ctx, version, 0, 0, 1, src, dst, ilen, &bad);
+    } else if (decrypt) {
+        trailer_crypt(trailer, ctx, 1, src, dst, olen);
+        trailer_final(trailer, mac);
+        if (memcmp(src + olen, mac, sizeof(mac)) != 0)
+            fatal("checksum mismatch!");
+    } else {
+        trailer_crypt(trailer, ctx, 0, src, dst, ilen);
+        trailer_final(trailer, mac);
+        memcpy(dst + ilen, mac, sizeof(mac));
+    }
+
+    munmap(ibase, imaplen);
+    if (munmap(obase, omaplen))
+        fatal("error writing %s file -- %s",
+              decrypt ? "plaintext" : "ciphertext", strerror(errno));
+    lseek(ofd, opos + olen, SEEK_SET);
+    return 0;
+}
+
+#else
+static int
+symmetric_mapped(FILE *in, FILE *out, const uint8_t *key,
+                 const uint8_t *iv, int decrypt, int version)
+{
+    (void)in;
+    (void)out;
+    (void)key;
+    (void)iv;
+    (void)decrypt;
+    (void)version;
+    return 1;
+}
+#endif /* ENCHIVE_OPTION_RAWIO */
+
 /**
- * Encrypt from file to file using key/iv, aborting on any error.
+ * Encrypt (DECRYPT = 0) or decrypt between regular files IN and OUT
+ * with io_uring, keeping several chunks in flight so the disk reads
+ * ahead of the cipher and writes behind it. Returns 0 when done, or
+ * 1 if io_uring or the files are unsuitable, in which case nothing
+ * has been changed and the caller should stream instead. Aborts on
+ * any error.
  */
-static void
-symmetric_encrypt(FILE *in, FILE *out, const uint8_t *key, const uint8_t *iv)
-{
-    static uint8_t buffer[2][CHACHA_BLOCKLENGTH * 1024];
-    uint8_t mac[SHA256_BLOCK_SIZE];
-    SHA256_CTX hmac[1];
-    chacha_ctx ctx[1];
+static int symmetric_uring(FILE *in, FILE *out, const uint8_t *key,
+                           const uint8_t *iv, int decrypt, int version);
+
+#if ENCHIVE_OPTION_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+/* Headers from before Linux 5.4 lack parts of the interface used here,
+ * so leave the backend out rather than fail the build. */
+#if !defined(IORING_FEAT_SINGLE_MMAP) || !defined(SYS_io_uring_setup)
+#  undef ENCHIVE_OPTION_URING
+#  define ENCHIVE_OPTION_URING 0
+#endif
+#endif
 
-    chacha_keysetup(ctx, key, 256);
-    chacha_ivsetup(ctx, iv);
-    hmac_init(hmac, key);
+#if ENCHIVE_OPTION_URING
+/* Chunks in flight, each with its own registered buffers. */
+#define URING_DEPTH 8
+
+/* A minimal io_uring through the raw system calls. */
+struct uring {
+    int fd;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_len;
+    size_t cq_len;
+    size_t sqes_len;
+    unsigned pending;   /* queued but not yet submitted */
+};
 
-    for (;;) {
-        size_t z = fread(buffer[0], 1, sizeof(buffer[0]), in);
-        if (!z) {
-            if (ferror(in))
-                fatal("error reading plaintext file");
-            break;
-        }
-        sha256_update(hmac, buffer[0], z);
-        chacha_encrypt(ctx, buffer[0], buffer[1], z);
-        if (!fwrite(buffer[1], z, 1, out))
-            fatal("error writing ciphertext file");
-        if (z < sizeof(buffer[0]))
-            break;
+/* Life cycle of each chunk buffer. */
+enum uring_state {
+    URING_FREE,
+    URING_READING,
+    URING_READY,
+    URING_WRITING
+};
+
+struct uring_slot {
+    uint8_t *in;        /* registered buffer i */
+    uint8_t *out;       /* registered buffer URING_DEPTH + i */
+    uint8_t *buf;       /* in or out, for the current operation */
+    uint64_t offset;    /* file offset of the current operation */
+    size_t len;         /* bytes in the current operation */
+    size_t done;        /* bytes already transferred */
+    enum uring_state state;
+};
+
+/**
+ * Create a ring with room for ENTRIES operations. Returns 0 on
+ * success, or -1 if io_uring is unavailable.
+ */
+static int
+uring_open(struct uring *u, unsigned entries)
+{
+    struct io_uring_params p;
+    uint8_t *sq, *cq;
+
+    memset(&p, 0, sizeof(p));
+    u->fd = syscall(SYS_io_uring_setup, entries, &p);
+    if (u->fd < 0)
+        return -1;
+
+    u->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_len > u->sq_len)
+            u->sq_len = u->cq_len;
+        u->cq_len = 0;
+    }
+    u->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+
+    u->sq_ring = mmap(0, u->sq_len, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+    u->cq_ring = u->sq_ring;
+    if (u->cq_len && u->sq_ring != MAP_FAILED)
+        u->cq_ring = mmap(0, u->cq_len, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+    u->sqes = mmap(0, u->sqes_len, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+    if (u->sq_ring == MAP_FAILED || u->cq_ring == MAP_FAILED ||
+        u->sqes == MAP_FAILED) {
+        if (u->sq_ring != MAP_FAILED)
+            munmap(u->sq_ring, u->sq_len);
+        if (u->cq_len && u->cq_ring != MAP_FAILED)
+            munmap(u->cq_ring, u->cq_len);
+        if (u->sqes != MAP_FAILED)
+            munmap(u->sqes, u->sqes_len);
+        close(u->fd);
+        return -1;
     }
 
-    hmac_final(hmac, key, mac);
+    sq = u->sq_ring;
+    cq = u->cq_ring;
+    u->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    u->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned *)(sq + p.sq_off.array);
+    u->cq_head = (unsigned *)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    u->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    u->pending = 0;
+    return 0;
+}
 
-    if (!fwrite(mac, sizeof(mac), 1, out))
-        fatal("error writing checksum to ciphertext file");
-    if (fflush(out))
-        fatal("error flushing to ciphertext file -- %s", strerror(errno));
+static void
+uring_close(struct uring *u)
+{
+    munmap(u->sqes, u->sqes_len);
+    if (u->cq_len)
+        munmap(u->cq_ring, u->cq_len);
+    munmap(u->sq_ring, u->sq_len);
+    close(u->fd);
 }
 
 /**
- * Decrypt from file to file using key/iv, aborting on any error.
+ * Queue a fixed-buffer read or write of slot I on FD.
  */
 static void
-symmetric_decrypt(FILE *in, FILE *out, const uint8_t *key, const uint8_t *iv)
+uring_queue(struct uring *u, int opcode, int fd,
+            struct uring_slot *slots, unsigned i)
+{
+    struct uring_slot *s = slots + i;
+    unsigned tail = *u->sq_tail;
+    unsigned index = tail & *u->sq_mask;
+    struct io_uring_sqe *sqe = u->sqes + index;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = s->offset + s->done;
+    sqe->addr = (uintptr_t)(s->buf + s->done);
+    sqe->len = s->len - s->done;
+    sqe->buf_index = s->buf == s->out ? URING_DEPTH + i : i;
+    sqe->user_data = i;
+    u->sq_array[index] = index;
+    __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    u->pending++;
+}
+
+/**
+ * Submit queued operations, and if WAIT, block for a completion.
+ */
+static void
+uring_submit(struct uring *u, int wait)
+{
+    while (u->pending || wait) {
+        unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+        long r = syscall(SYS_io_uring_enter, u->fd, u->pending,
+                         wait ? 1 : 0, flags, (void *)0, 0);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            fatal("io_uring_enter() failed -- %s", strerror(errno));
+        }
+        u->pending -= r;
+        wait = 0;
+    }
+}
+
+static int
+symmetric_uring(FILE *in, FILE *out, const uint8_t *key,
+                const uint8_t *iv, int decrypt, int version)
 {
-    static uint8_t buffer[2][CHACHA_BLOCKLENGTH * 1024 + SHA256_BLOCK_SIZE];
+    size_t record = SEGMENT_SIZE + segment_tag(version);
+    int segmented = segment_tag(version) != 0;
+    int ifd = fileno(in);
+    int ofd = fileno(out);
+    struct stat ist, ost;
+    off_t ipos, opos;
+    uint64_t len, nchunks, end = 0;
+    uint64_t nread = 0, ncrypt = 0, nwrite = 0;
+    size_t inlen, outlen, batch = 0;
+    struct uring u[1];
+    struct uring_slot slots[URING_DEPTH];
+    struct iovec iov[2 * URING_DEPTH];
+    uint8_t *buffer;
     uint8_t mac[SHA256_BLOCK_SIZE];
-    SHA256_CTX hmac[1];
+    uint8_t tail[SHA256_BLOCK_SIZE];
+    struct trailer trailer[1];
     chacha_ctx ctx[1];
+    unsigned i;
 
-    chacha_keysetup(ctx, key, 256);
-    chacha_ivsetup(ctx, iv);
-    hmac_init(hmac, key);
+    if (fstat(ifd, &ist) || !S_ISREG(ist.st_mode) ||
+        fstat(ofd, &ost) || !S_ISREG(ost.st_mode))
+        return 1;
+    ipos = lseek(ifd, 0, SEEK_CUR);
+    opos = lseek(ofd, 0, SEEK_CUR);
+    if (ipos < 0 || opos < 0 || ist.st_size < ipos)
+        return 1;
 
-    /* Always keep SHA256_BLOCK_SIZE bytes in the buffer. */
-    if (!(fread(buffer[0], SHA256_BLOCK_SIZE, 1, in))) {
-        if (ferror(in))
-            fatal("cannot read ciphertext file");
-        else
-            fatal("ciphertext file too short");
+    if (segmented) {
+        /* The last chunk is short, and holds the final segment. */
+        batch = segment_batch(in, out);
+        inlen = batch * (decrypt ? record : SEGMENT_SIZE);
+        outlen = batch * (decrypt ? SEGMENT_SIZE : record);
+        len = ist.st_size - ipos;
+        nchunks = len / inlen + 1;
+    } else {
+        /* Empty and truncated inputs are left to the streaming path. */
+        if (decrypt) {
+            switch (io_tail(in, tail, sizeof(tail), &len)) {
+                case -1:
+                    fatal("cannot read ciphertext file");
+                    break;
+                case 1:
+                    return 1;
+            }
+        } else {
+            len = ist.st_size - ipos;
+        }
+        if (!len)
+            return 1;
+        inlen = outlen = io_bufsize(in, out);
+        nchunks = (len + inlen - 1) / inlen;
     }
 
-    for (;;) {
-        uint8_t *p = buffer[0] + SHA256_BLOCK_SIZE;
-        size_t z = fread(p, 1, sizeof(buffer[0]) - SHA256_BLOCK_SIZE, in);
-        if (!z) {
-            if (ferror(in))
-                fatal("error reading ciphertext file");
-            break;
-        }
-        chacha_encrypt(ctx, buffer[0], buffer[1], z);
-        sha256_update(hmac, buffer[1], z);
-        if (!fwrite(buffer[1], z, 1, out))
-            fatal("error writing plaintext file");
+    buffer = malloc(URING_DEPTH * (inlen + outlen + SHA256_BLOCK_SIZE));
+    if (!buffer)
+        fatal("out of memory");
+    for (i = 0; i < URING_DEPTH; i++) {
+        slots[i].in = buffer + i * (inlen + outlen + SHA256_BLOCK_SIZE);
+        slots[i].out = slots[i].in + inlen;
+        slots[i].state = URING_FREE;
+        iov[i].iov_base = slots[i].in;
+        iov[i].iov_len = inlen;
+        iov[URING_DEPTH + i].iov_base = slots[i].out;
+        iov[URING_DEPTH + i].iov_len = outlen + SHA256_BLOCK_SIZE;
+    }
 
-        /* Move last SHA256_BLOCK_SIZE bytes to the front. */
-        memmove(buffer[0], buffer[0] + z, SHA256_BLOCK_SIZE);
+    if (uring_open(u, URING_DEPTH)) {
+        free(buffer);
+        return 1;
+    }
+    if (syscall(SYS_io_uring_register, u->fd, IORING_REGISTER_BUFFERS,
+                iov, 2 * URING_DEPTH)) {
+        uring_close(u);
+        free(buffer);
+        return 1;
+    }
 
-        if (z < sizeof(buffer[0]) - SHA256_BLOCK_SIZE)
-            break;
+    cipher_init(ctx, key, iv, version);
+    trailer_init(trailer, key, version);
+
+    /* Chunk n always lives in slot n % URING_DEPTH. Reads complete in
+     * any order, but the cipher and HMAC take chunks strictly in
+     * order, and a slot is reused only once its write completes. */
+    while (nwrite < nchunks) {
+        unsigned head, ctail;
+
+        while (nread < nchunks &&
+               slots[nread % URING_DEPTH].state == URING_FREE) {
+            struct uring_slot *s = slots + nread % URING_DEPTH;
+            uint64_t off = nread * inlen;
+            s->buf = s->in;
+            s->offset = ipos + off;
+            s->len = len - off < inlen ? len - off : inlen;
+            s->done = 0;
+            s->state = URING_READING;
+            if (s->len)
+                uring_queue(u, IORING_OP_READ_FIXED, ifd,
+                            slots, nread % URING_DEPTH);
+            else
+                s->state = URING_READY; /* empty final segment */
+            nread++;
+        }
+        uring_submit(u, 0);
+
+        while (ncrypt < nread &&
+               slots[ncrypt % URING_DEPTH].state == URING_READY) {
+            struct uring_slot *s = slots + ncrypt % URING_DEPTH;
+            uint64_t n = ncrypt++;
+            if (segmented) {
+                int bad;
+                s->len = segment_crypt(key, ctx, version, n * batch,
+                                       decrypt, n == nchunks - 1,
+                                       s->in, s->out, s->len, &bad);
+                if (bad)
+                    fatal("checksum mismatch!");
+            } else if (decrypt) {
+                trailer_crypt(trailer, ctx, 1, s->in, s->out, s->len);
+            } else {
+                trailer_crypt(trailer, ctx, 0, s->in, s->out, s->len);
+            }
+            if (!segmented && n == nchunks - 1) {
+                trailer_final(trailer, mac);
+                if (!decrypt) {
+                    /* The MAC rides along with the last chunk. */
+                    memcpy(s->out + s->len, mac, sizeof(mac));
+                    s->len += sizeof(mac);
+                }
+            }
+            s->buf = s->out;
+            s->offset = opos + n * outlen;
+            s->done = 0;
+            s->state = URING_WRITING;
+            end = s->offset + s->len;
+            if (!s->len) {
+                /* Empty final segment: nothing to write. */
+                s->state = URING_FREE;
+                nwrite++;
+                continue;
+            }
+            uring_queue(u, IORING_OP_WRITE_FIXED, ofd,
+                        slots, n % URING_DEPTH);
+            uring_submit(u, 0);
+        }
+
+        head = *u->cq_head;
+        ctail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+        if (head == ctail && nwrite < nchunks) {
+            uring_submit(u, 1);
+            ctail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+        }
+        for (; head != ctail; head++) {
+            struct io_uring_cqe *cqe = u->cqes + (head & *u->cq_mask);
+            unsigned n = cqe->user_data;
+            struct uring_slot *s = slots + n;
+            int reading = s->state == URING_READING;
+            if (cqe->res == -EINTR || cqe->res == -EAGAIN) {
+                uring_queue(u, reading ? IORING_OP_READ_FIXED
+                                       : IORING_OP_WRITE_FIXED,
+                            reading ? ifd : ofd, slots, n);
+                continue;
+            }
+            if (cqe->res <= 0)
+                fatal("error %s %s file -- %s",
+                      reading ? "reading" : "writing",
+                      reading == !decrypt ? "plaintext" : "ciphertext",
+                      cqe->res ? strerror(-cqe->res) : "unexpected end");
+            s->done += cqe->res;
+            if (s->done < s->len) {
+                /* Short transfer: go again for the remainder. */
+                uring_queue(u, reading ? IORING_OP_READ_FIXED
+                                       : IORING_OP_WRITE_FIXED,
+                            reading ? ifd : ofd, slots, n);
+            } else if (reading) {
+                s->state = URING_READY;
+            } else {
+                s->state = URING_FREE;
+                nwrite++;
+            }
+        }
+        __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
     }
 
-    hmac_final(hmac, key, mac);
-    if (memcmp(buffer[0], mac, sizeof(mac)) != 0)
+    uring_close(u);
+    free(buffer);
+    if (!segmented && decrypt && memcmp(tail, mac, sizeof(mac)) != 0)
         fatal("checksum mismatch!");
-    if (fflush(out))
-        fatal("error flushing to plaintext file -- %s", strerror(errno));
+    lseek(ofd, end, SEEK_SET);
+    return 0;
+}
+
+#else
+static int
+symmetric_uring(FILE *in, FILE *out, const uint8_t *key,
+                const uint8_t *iv, int decrypt, int version)
+{
+    (void)in;
+    (void)out;
+    (void)key;
+    (void)iv;
+    (void)decrypt;
+    (void)version;
+    return 1;
+}
+#endif /* ENCHIVE_OPTION_URING */
 
+/**
+ * Encrypt (DECRYPT = 0) or decrypt IN to OUT in archive format
+ * VERSION using key/iv, with the backend selected by --io and JOBS
+ * cipher threads (0 for none). Aborts on any error.
+ */
+static void
+symmetric_copy(FILE *in, FILE *out, const uint8_t *key,
+               const uint8_t *iv, int decrypt, int version, int jobs)
+{
+    io_pipe(in);
+    io_pipe(out);
+    if (io_backend == IO_MMAP) {
+        if (!symmetric_mapped(in, out, key, iv, decrypt, version)) {
+            if (jobs)
+                warning("--jobs (-j) has no effect with --io mmap");
+            return;
+        }
+        info("cannot map files, streaming instead");
+    } else if (io_backend == IO_URING) {
+        if (!symmetric_uring(in, out, key, iv, decrypt, version)) {
+            if (jobs)
+                warning("--jobs (-j) has no effect with --io uring");
+            return;
+        }
+        info("cannot use io_uring here, streaming instead");
+    }
+    if (jobs)
+        symmetric_pipeline(in, out, key, iv, decrypt, version, jobs);
+    else if (segment_tag(version))
+        segment_stream(in, out, key, iv, decrypt, version);
+    else if (decrypt)
+        symmetric_decrypt(in, out, key, iv, version);
+    else
+        symmetric_encrypt(in, out, key, iv, version);
 }
 
 /**
@@ -1108,17 +3406,271 @@ write_seckey(char *file, const uint8_t *seckey, int iexp)
 /**
  * Load the public key from the file.
  */
+/* Suffix of the precomputed table file next to a public key file */
+static const char pubtable_suffix[] = ".table";
+
+/**
+ * Compute the check stored at the front of a table file, binding the
+ * table to its public key.
+ */
+static void
+pubtable_check(uint8_t *check, const uint8_t *key, const uint8_t *table)
+{
+    SHA256_CTX sha[1];
+    sha256_init(sha);
+    sha256_update(sha, key, 32);
+    sha256_update(sha, table, CURVE25519_TABLE_SIZE);
+    sha256_final(sha, check);
+}
+
+/**
+ * Load the precomputed table for the public key KEY stored in FILE,
+ * if there is one. A missing, stale, or damaged table isn't an error,
+ * since the key works just as well without it. The check only catches
+ * accidents: anyone who can write the table can recompute it, so the
+ * table must be guarded like the public key file itself, and
+ * verify_pubtable() is the real test.
+ */
+static void
+load_pubtable(const char *file, const uint8_t *key)
+{
+    uint8_t check[SHA256_BLOCK_SIZE];
+    uint8_t expect[SHA256_BLOCK_SIZE];
+    char *tablefile = joinstr(2, file, pubtable_suffix);
+    FILE *f = fopen(tablefile, "rb");
+
+    if (f) {
+        if (!fread(check, sizeof(check), 1, f) ||
+            !fread(pubtable, sizeof(pubtable), 1, f)) {
+            info("ignoring truncated table '%s'", tablefile);
+        } else {
+            pubtable_check(expect, key, pubtable);
+            if (memcmp(check, expect, sizeof(check)) != 0) {
+                info("ignoring table '%s' not matching the public key",
+                     tablefile);
+            } else {
+                memcpy(pubtable_key, key, 32);
+                pubtable_loaded = 1;
+                info("using table '%s'", tablefile);
+            }
+        }
+        fclose(f);
+    }
+    free(tablefile);
+}
+
+/**
+ * Abort unless the table loaded by load_pubtable() for KEY from FILE,
+ * if any, is exactly the one the table command makes for KEY. Unlike
+ * the check on loading, this also catches a table forged for another
+ * point, at the cost of building the table again.
+ */
+static void
+verify_pubtable(const char *file, const uint8_t *key)
+{
+    static const uint8_t one[32] = {1};
+    static uint8_t expect[CURVE25519_TABLE_SIZE];
+    uint8_t probe[32];
+    char *tablefile;
+
+    if (!pubtable_loaded)
+        return;
+    tablefile = joinstr(2, file, pubtable_suffix);
+    if (curve25519_donna_table(probe, one, pubtable))
+        info("table '%s' is unused by the %s kernel", tablefile,
+             curve25519_kernels[curve25519_kernel_current()].name);
+    else if (curve25519_table(expect, key) ||
+             memcmp(expect, pubtable, sizeof(pubtable)) != 0)
+        fatal("table '%s' was not made for this public key", tablefile);
+    else
+        info("table '%s' matches the public key", tablefile);
+    free(tablefile);
+}
+
 static void
 load_pubkey(const char *file, uint8_t *key)
 {
-    FILE *f = fopen(file, "rb");
-    if (!f)
-        fatal("failed to open key file for reading '%s' -- %s",
-              file, strerror(errno));
-    if (!fread(key, 32, 1, f))
-        fatal("failed to read key file '%s'", file);
-    fclose(f);
+    FILE *f = fopen(file, "rb");
+    if (!f)
+        fatal("failed to open key file for reading '%s' -- %s",
+              file, strerror(errno));
+    if (!fread(key, 32, 1, f))
+        fatal("failed to read key file '%s'", file);
+    fclose(f);
+    load_pubtable(file, key);
+}
+
+/**
+ * Take one ready ephemeral key pair for the public key PUBLIC from a
+ * running pool: the ephemeral public key and the shared secret it
+ * makes with PUBLIC. Returns 1 on success, or 0 when there's no pool.
+ */
+static int pool_read(uint8_t *epublic, uint8_t *shared,
+                     const uint8_t *public);
+
+/**
+ * Fork a pool process serving fresh ephemeral key pairs for PUBLIC,
+ * each handed out only once. It tops up the pool while idle and exits
+ * once TIMEOUT seconds pass without a request.
+ */
+static int pool_run(const uint8_t *public, int timeout);
+
+#if ENCHIVE_OPTION_AGENT
+/**
+ * Derive the pool socket identifier from the public key.
+ */
+static void
+pool_id(uint8_t *id, const uint8_t *public)
+{
+    SHA256_CTX sha[1];
+    sha256_init(sha);
+    sha256_update(sha, public, 32);
+    sha256_final(sha, id);
+}
+
+/**
+ * Make a new ephemeral key pair entry (epublic, shared) for PUBLIC.
+ */
+static void
+pool_fill(uint8_t *pair, const uint8_t *public)
+{
+    uint8_t esecret[32];
+    generate_secret(esecret);
+    compute_public(pair, esecret);
+    compute_shared(pair + 32, esecret, public);
+}
+
+static int
+pool_read(uint8_t *epublic, uint8_t *shared, const uint8_t *public)
+{
+    int success;
+    uint8_t id[SHA256_BLOCK_SIZE];
+    uint8_t pair[64];
+    struct sockaddr_un addr;
+    int fd;
+
+    pool_id(id, public);
+    if (!agent_addr(&addr, id, ".pool"))
+        return 0;
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+        return 0;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+        close(fd);
+        return 0;
+    }
+    success = read(fd, pair, sizeof(pair)) == sizeof(pair);
+    close(fd);
+    if (success) {
+        memcpy(epublic, pair, 32);
+        memcpy(shared, pair + 32, 32);
+    }
+    return success;
+}
+
+static int
+pool_run(const uint8_t *public, int timeout)
+{
+    static uint8_t pool[ENCHIVE_POOL_SIZE][64];
+    struct pollfd pfd = {-1, POLLIN, 0};
+    struct sockaddr_un addr;
+    uint8_t id[SHA256_BLOCK_SIZE];
+    int count = 0;
+    pid_t pid;
+
+    pool_id(id, public);
+    if (!agent_addr(&addr, id, ".pool"))
+        return 0;
+
+    pfd.fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (pfd.fd == -1) {
+        warning("could not create pool socket");
+        return 0;
+    }
+
+    pid = fork();
+    if (pid == -1) {
+        warning("could not fork() pool -- %s", strerror(errno));
+        close(pfd.fd);
+        return 0;
+    } else if (pid != 0) {
+        close(pfd.fd);
+        return 1;
+    }
+    close(0);
+    close(1);
+
+    umask(~(S_IRUSR | S_IWUSR));
+
+    if (unlink(addr.sun_path))
+        if (errno != ENOENT)
+            fatal("failed to remove existing socket -- %s", strerror(errno));
+
+    if (bind(pfd.fd, (struct sockaddr *)&addr, sizeof(addr))) {
+        if (errno != EADDRINUSE)
+            warning("could not bind pool socket %s -- %s",
+                    addr.sun_path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    if (listen(pfd.fd, SOMAXCONN)) {
+        if (errno != EADDRINUSE)
+            fatal("could not listen on pool socket -- %s", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    close(2);
+    for (;;) {
+        int cfd;
+        int full = count == ENCHIVE_POOL_SIZE;
+        int r = poll(&pfd, 1, full ? timeout * 1000 : 0);
+        if (r < 0) {
+            unlink(addr.sun_path);
+            fatal("pool poll failed -- %s", strerror(errno));
+        }
+        if (r == 0) {
+            if (!full) {
+                /* Idle: top up the pool. */
+                pool_fill(pool[count++], public);
+                continue;
+            }
+            unlink(addr.sun_path);
+            close(pfd.fd);
+            break;
+        }
+        cfd = accept(pfd.fd, 0, 0);
+        if (cfd != -1) {
+            if (!count)
+                pool_fill(pool[count++], public);
+            count--;
+            if (write(cfd, pool[count], 64) != 64)
+                warning("pool write failed");
+            /* Never hand out the same pair twice, even on failure. */
+            memset(pool[count], 0, 64);
+            close(cfd);
+        }
+    }
+    exit(EXIT_SUCCESS);
+}
+
+#else
+static int
+pool_read(uint8_t *epublic, uint8_t *shared, const uint8_t *public)
+{
+    (void)epublic;
+    (void)shared;
+    (void)public;
+    return 0;
+}
+
+static int
+pool_run(const uint8_t *public, int timeout)
+{
+    (void)public;
+    (void)timeout;
+    return 0;
 }
+#endif
 
 /**
  * Attempt to load and decrypt the secret key stored in a file.
@@ -1245,11 +3797,13 @@ enum command {
     COMMAND_KEYGEN,
     COMMAND_FINGERPRINT,
     COMMAND_ARCHIVE,
-    COMMAND_EXTRACT
+    COMMAND_EXTRACT,
+    COMMAND_TABLE,
+    COMMAND_BENCH
 };
 
 static const char command_names[][12] = {
-    "keygen", "fingerprint", "archive", "extract"
+    "keygen", "fingerprint", "archive", "extract", "table", "bench"
 };
 
 /**
@@ -1272,6 +3826,158 @@ parse_command(char *command)
     return found;
 }
 
+/**
+ * Scale *N by a K, M, or G (binary) suffix at *P, if present, and
+ * advance *P past it.
+ */
+static void
+parse_scale(double *n, char **p)
+{
+    switch (**p) {
+        case 'g':
+        case 'G':
+            *n *= 1024.0;
+            /* FALLTHROUGH */
+        case 'm':
+        case 'M':
+            *n *= 1024.0;
+            /* FALLTHROUGH */
+        case 'k':
+        case 'K':
+            *n *= 1024.0;
+            (*p)++;
+    }
+}
+
+/**
+ * Parse a key derivation exponent argument for option NAME, aborting
+ * if invalid. Returns 0 for "auto[:TIME[,MEMORY]]", filling in the
+ * targets, where TIME is in seconds ("s") or milliseconds ("ms") and
+ * MEMORY is in bytes with an optional K, M, or G suffix.
+ */
+static int
+parse_iexp(const char *name, const char *arg, double *seconds, double *memory)
+{
+    char *p;
+    long n;
+
+    if (!strncmp(arg, "auto", 4) && (!arg[4] || arg[4] == ':')) {
+        const char *s = arg[4] ? arg + 5 : arg + 4;
+        *seconds = KDF_AUTO_SECONDS;
+        *memory = KDF_AUTO_MEMORY;
+        if (*s && *s != ',') {
+            *seconds = strtod(s, &p);
+            if (p[0] == 'm' && p[1] == 's') {
+                *seconds /= 1000;
+                p += 2;
+            } else if (p[0] == 's') {
+                p++;
+            }
+            if (p == s || *seconds <= 0 || (*p && *p != ','))
+                fatal("invalid %s time -- %s", name, arg);
+            s = p;
+        }
+        if (*s == ',') {
+            s++;
+            *memory = strtod(s, &p);
+            parse_scale(memory, &p);
+            if (p == s || *memory <= 0 || *p)
+                fatal("invalid %s memory -- %s", name, arg);
+        }
+        return 0;
+    }
+
+    errno = 0;
+    n = strtol(arg, &p, 10);
+    if (errno || *p)
+        fatal("invalid argument -- %s", arg);
+    if (n < 5 || n > 31)
+        fatal("%s argument must be 5 <= n <= 31 -- %s", name, arg);
+    return n;
+}
+
+/**
+ * Parse the argument to --buffer-size (-b), a byte count with an
+ * optional K, M, or G suffix, aborting if invalid.
+ */
+static size_t
+parse_buffer_size(const char *arg)
+{
+    char *p;
+    double n = strtod(arg, &p);
+    if (p != arg)
+        parse_scale(&n, &p);
+    if (p == arg || *p || n < CHACHA_BLOCKLENGTH || n > 1024.0 * 1024 * 1024)
+        fatal("invalid --buffer-size (-b) -- %s", arg);
+    return n;
+}
+
+/**
+ * Parse the argument to option NAME, a plaintext position or length
+ * in bytes with an optional K, M, or G suffix, aborting if invalid.
+ */
+static uint64_t
+parse_range(const char *name, const char *arg)
+{
+    char *p;
+    double n = strtod(arg, &p);
+    if (p != arg)
+        parse_scale(&n, &p);
+    /* Exact up to 2^53, which is plenty. */
+    if (p == arg || *p || n < 0 || n > 9007199254740992.0 || n != (uint64_t)n)
+        fatal("invalid %s -- %s", name, arg);
+    return n;
+}
+
+/**
+ * Parse the argument to --io (-i), aborting if invalid.
+ */
+static enum io_backend
+parse_io(const char *arg)
+{
+    if (!strcmp(arg, "stream"))
+        return IO_STREAM;
+    if (!strcmp(arg, "splice"))
+        return IO_SPLICE;
+    if (!strcmp(arg, "mmap"))
+        return IO_MMAP;
+    if (!strcmp(arg, "uring"))
+        return IO_URING;
+    fatal("invalid --io (-i), must be stream, splice, mmap, or uring -- %s",
+          arg);
+    return IO_STREAM;
+}
+
+/**
+ * Parse the argument to --format (-f), aborting if invalid.
+ */
+static int
+parse_format(const char *arg)
+{
+    char *p;
+    long n;
+    errno = 0;
+    n = strtol(arg, &p, 10);
+    if (errno || *p || n < 3 || n > 8)
+        fatal("invalid --format (-f), must be 3 to 8 -- %s", arg);
+    return n;
+}
+
+/**
+ * Parse the argument to --jobs (-j), aborting if invalid.
+ */
+static int
+parse_jobs(const char *arg)
+{
+    char *p;
+    long n;
+    errno = 0;
+    n = strtol(arg, &p, 10);
+    if (errno || *p || n < 1 || n > 256)
+        fatal("invalid --jobs (-j) -- %s", arg);
+    return n;
+}
+
 static void
 command_keygen(struct optparse *options)
 {
@@ -1300,26 +4006,19 @@ command_keygen(struct optparse *options)
     int repeats = 1;
     int key_derive_iterations = ENCHIVE_KEY_DERIVE_ITERATIONS;
     int seckey_derive_iterations = ENCHIVE_SECKEY_DERIVE_ITERATIONS;
+    double key_auto[2];
+    double seckey_auto[2];
 
     int option;
     while ((option = optparse_long(options, keygen, 0)) != -1) {
         switch (option) {
-            case 'd': {
-                char *p;
-                char *arg = options->optarg;
+            case 'd':
                 derive = 1;
-                if (arg) {
-                    long n;
-                    errno = 0;
-                    n = strtol(arg, &p, 10);
-                    if (errno || *p)
-                        fatal("invalid argument -- %s", arg);
-                    if (n < 5 || n > 31)
-                        fatal("--derive argument must be 5 <= n <= 31 -- %s",
-                              arg);
-                    seckey_derive_iterations = n;
-                }
-            } break;
+                if (options->optarg)
+                    seckey_derive_iterations =
+                        parse_iexp("--derive", options->optarg,
+                                   &seckey_auto[0], &seckey_auto[1]);
+                break;
             case 'e':
                 edit = 1;
                 break;
@@ -1329,19 +4028,11 @@ command_keygen(struct optparse *options)
             case 'i':
                 fingerprint = 1;
                 break;
-            case 'k': {
-                char *p;
-                char *arg = options->optarg;
-                long n;
-                errno = 0;
-                n = strtol(arg, &p, 10);
-                if (errno || *p)
-                    fatal("invalid argument -- %s", arg);
-                if (n < 5 || n > 31)
-                    fatal("--iterations argument must be 5 <= n <= 31 -- %s",
-                          arg);
-                key_derive_iterations = n;
-            } break;
+            case 'k':
+                key_derive_iterations =
+                    parse_iexp("--iterations", options->optarg,
+                               &key_auto[0], &key_auto[1]);
+                break;
             case 'r': {
                 char *p;
                 char *arg = options->optarg;
@@ -1363,6 +4054,14 @@ command_keygen(struct optparse *options)
     if (edit && derive)
         fatal("--edit and --derive are mutually exclusive");
 
+    /* Calibrate before prompting so the passphrase isn't held longer. */
+    if (derive && !seckey_derive_iterations)
+        seckey_derive_iterations =
+            kdf_calibrate("--derive", seckey_auto[0], seckey_auto[1]);
+    if (protect && !key_derive_iterations)
+        key_derive_iterations =
+            kdf_calibrate("--iterations", key_auto[0], key_auto[1]);
+
     if (!pubfile)
         pubfile = default_pubfile();
     pubfile_exists = file_exists(pubfile);
@@ -1434,6 +4133,7 @@ command_fingerprint(struct optparse *options)
     if (!pubfile)
         pubfile = default_pubfile();
     load_pubkey(pubfile, public);
+    verify_pubtable(pubfile, public);
     free(pubfile);
 
     print_fingerprint(public);
@@ -1444,7 +4144,14 @@ static void
 command_archive(struct optparse *options)
 {
     static const struct optparse_long archive[] = {
-        {"delete", 'd', OPTPARSE_NONE},
+        {"buffer-size", 'b', OPTPARSE_REQUIRED},
+        {"delete",      'd', OPTPARSE_NONE},
+        {"format",      'f', OPTPARSE_REQUIRED},
+        {"io",          'i', OPTPARSE_REQUIRED},
+        {"jobs",        'j', OPTPARSE_REQUIRED},
+#if ENCHIVE_OPTION_AGENT
+        {"pool",        'P', OPTPARSE_OPTIONAL},
+#endif
         {0, 0, 0}
     };
 
@@ -1455,6 +4162,9 @@ command_archive(struct optparse *options)
     FILE *out = stdout;
     char *pubfile = dupstr(global_pubkey);
     int delete = 0;
+    int format = ENCHIVE_ARCHIVE_FORMAT;
+    int jobs = 0;
+    int pool = 0;
 
     /* Workspace */
     uint8_t public[32];
@@ -1462,14 +4172,38 @@ command_archive(struct optparse *options)
     uint8_t epublic[32];
     uint8_t shared[32];
     uint8_t iv[SHA256_BLOCK_SIZE];
+    struct iobuf header[2];
     SHA256_CTX sha[1];
 
     int option;
     while ((option = optparse_long(options, archive, 0)) != -1) {
         switch (option) {
+            case 'b':
+                io_buflen = parse_buffer_size(options->optarg);
+                break;
             case 'd':
                 delete = 1;
                 break;
+            case 'f':
+                format = parse_format(options->optarg);
+                break;
+            case 'i':
+                io_backend = parse_io(options->optarg);
+                break;
+            case 'j':
+                jobs = parse_jobs(options->optarg);
+                break;
+            case 'P':
+                if (options->optarg) {
+                    char *arg = options->optarg;
+                    char *endptr;
+                    errno = 0;
+                    pool = strtol(arg, &endptr, 10);
+                    if (*endptr || errno || pool < 1)
+                        fatal("invalid --pool argument -- %s", arg);
+                } else
+                    pool = ENCHIVE_POOL_TIMEOUT;
+                break;
             default:
                 fatal("%s", options->errmsg);
         }
@@ -1480,6 +4214,17 @@ command_archive(struct optparse *options)
     load_pubkey(pubfile, public);
     free(pubfile);
 
+    /* Ephemeral keypair and the shared secret with the master key.
+     * Set this up before opening any files so a new pool process
+     * doesn't inherit them. */
+    if (!pool || !pool_read(epublic, shared, public)) {
+        generate_secret(esecret);
+        compute_public(epublic, esecret);
+        compute_shared(shared, esecret, public);
+        if (pool)
+            pool_run(public, pool);
+    }
+
     infile = optparse_arg(options);
     if (infile) {
         in = fopen(infile, "rb");
@@ -1494,28 +4239,24 @@ command_archive(struct optparse *options)
         outfile = joinstr(2, infile, enchive_suffix);
     }
     if (outfile) {
-        out = fopen(outfile, "wb");
+        out = fopen(outfile, "w+b"); /* readable for --io mmap */
         if (!out)
             fatal("could not open output file '%s' -- %s",
                   outfile, strerror(errno));
         cleanup_register(out, outfile);
     }
 
-    /* Generare ephemeral keypair. */
-    generate_secret(esecret);
-    compute_public(epublic, esecret);
-
-    /* Create shared secret between ephemeral key and master key. */
-    compute_shared(shared, esecret, public);
     sha256_init(sha);
     sha256_update(sha, shared, sizeof(shared));
     sha256_final(sha, iv);
-    iv[0] += (unsigned)ENCHIVE_FORMAT_VERSION;
-    if (!fwrite(iv, 8, 1, out))
-        fatal("failed to write IV to archive");
-    if (!fwrite(epublic, sizeof(epublic), 1, out))
-        fatal("failed to write ephemeral key to archive");
-    symmetric_encrypt(in, out, shared, iv);
+    iv[0] += (unsigned)format;
+    header[0].buf = iv;
+    header[0].len = 8;
+    header[1].buf = epublic;
+    header[1].len = sizeof(epublic);
+    if (io_write(out, header, 2))
+        fatal("failed to write header to archive");
+    symmetric_copy(in, out, shared, iv, 0, format, jobs);
 
     if (in != stdin)
         fclose(in);
@@ -1533,7 +4274,12 @@ static void
 command_extract(struct optparse *options)
 {
     static const struct optparse_long extract[] = {
-        {"delete", 'd', OPTPARSE_NONE},
+        {"buffer-size", 'b', OPTPARSE_REQUIRED},
+        {"delete",      'd', OPTPARSE_NONE},
+        {"io",          'i', OPTPARSE_REQUIRED},
+        {"jobs",        'j', OPTPARSE_REQUIRED},
+        {"length",      'l', OPTPARSE_REQUIRED},
+        {"offset",      'o', OPTPARSE_REQUIRED},
         {0, 0, 0}
     };
 
@@ -1544,6 +4290,10 @@ command_extract(struct optparse *options)
     FILE *out = stdout;
     char *secfile = dupstr(global_seckey);
     int delete = 0;
+    int jobs = 0;
+    int range = 0;
+    uint64_t offset = 0;
+    uint64_t length = RANGE_ALL;
 
     /* Workspace */
     SHA256_CTX sha[1];
@@ -1552,13 +4302,31 @@ command_extract(struct optparse *options)
     uint8_t shared[32];
     uint8_t iv[8];
     uint8_t check_iv[SHA256_BLOCK_SIZE];
+    int version;
 
     int option;
     while ((option = optparse_long(options, extract, 0)) != -1) {
         switch (option) {
+            case 'b':
+                io_buflen = parse_buffer_size(options->optarg);
+                break;
             case 'd':
                 delete = 1;
                 break;
+            case 'i':
+                io_backend = parse_io(options->optarg);
+                break;
+            case 'j':
+                jobs = parse_jobs(options->optarg);
+                break;
+            case 'l':
+                length = parse_range("--length (-l)", options->optarg);
+                range = 1;
+                break;
+            case 'o':
+                offset = parse_range("--offset (-o)", options->optarg);
+                range = 1;
+                break;
             default:
                 fatal("%s", options->errmsg);
         }
@@ -1588,28 +4356,36 @@ command_extract(struct optparse *options)
         outfile[len - slen] = 0;
     }
     if (outfile) {
-        out = fopen(outfile, "wb");
+        out = fopen(outfile, "w+b"); /* readable for --io mmap */
         if (!out)
             fatal("could not open output file '%s' -- %s",
                   infile, strerror(errno));
         cleanup_register(out, outfile);
     }
 
-    if (!(fread(iv, sizeof(iv), 1, in)))
+    if (io_read(in, iv, sizeof(iv)) != sizeof(iv))
         fatal("failed to read IV from archive");
-    if (!(fread(epublic, sizeof(epublic), 1, in)))
+    if (io_read(in, epublic, sizeof(epublic)) != sizeof(epublic))
         fatal("failed to read ephemeral key from archive");
     compute_shared(shared, secret, epublic);
 
-    /* Validate key before processing the file. */
+    /* Validate key before processing the file. The first byte of the
+     * IV is offset by the format version. */
     sha256_init(sha);
     sha256_update(sha, shared, sizeof(shared));
     sha256_final(sha, check_iv);
-    check_iv[0] += (unsigned)ENCHIVE_FORMAT_VERSION;
-    if (memcmp(iv, check_iv, sizeof(iv)) != 0)
+    version = (iv[0] - check_iv[0]) & 0xff;
+    if (memcmp(iv + 1, check_iv + 1, sizeof(iv) - 1) != 0 ||
+        version < 3 || version > 8)
         fatal("invalid master key or format");
 
-    symmetric_decrypt(in, out, shared, iv);
+    if (!range)
+        symmetric_copy(in, out, shared, iv, 1, version, jobs);
+    else if (segment_tag(version))
+        segment_range(in, out, shared, iv, version, offset, length);
+    else
+        fatal("--offset and --length need a segmented archive "
+              "(format 4, 5, 7, or 8)");
 
     if (in != stdin)
         fclose(in);
@@ -1622,6 +4398,403 @@ command_extract(struct optparse *options)
         remove(infile);
 }
 
+static void
+command_table(struct optparse *options)
+{
+    static const struct optparse_long table[] = {
+        {0, 0, 0}
+    };
+
+    char *pubfile = dupstr(global_pubkey);
+    char *tablefile;
+    uint8_t public[32];
+    uint8_t check[SHA256_BLOCK_SIZE];
+    FILE *f;
+
+    int option;
+    while ((option = optparse_long(options, table, 0)) != -1) {
+        switch (option) {
+            default:
+                fatal("%s", options->errmsg);
+        }
+    }
+
+    if (!pubfile)
+        pubfile = default_pubfile();
+    load_pubkey(pubfile, public);
+    tablefile = joinstr(2, pubfile, pubtable_suffix);
+    free(pubfile);
+
+    if (curve25519_table(pubtable, public))
+        fatal("cannot make a table for this key with the %s kernel",
+              curve25519_kernels[curve25519_kernel_current()].name);
+    pubtable_check(check, public, pubtable);
+
+    f = fopen(tablefile, "wb");
+    if (!f)
+        fatal("failed to open table file for writing '%s' -- %s",
+              tablefile, strerror(errno));
+    cleanup_register(f, tablefile);
+    if (!fwrite(check, sizeof(check), 1, f) ||
+        !fwrite(pubtable, sizeof(pubtable), 1, f))
+        fatal("failed to write table file '%s'", tablefile);
+    cleanup_closed(f);
+    if (fclose(f))
+        fatal("failed to flush table file '%s' -- %s",
+              tablefile, strerror(errno));
+}
+
+/* Minimum CPU time spent measuring each benchmark, in seconds. */
+#define BENCH_SECONDS 0.25
+
+/* Message size for throughput benchmarks, matching the I/O buffers. */
+#define BENCH_BUFLEN (CHACHA_BLOCKLENGTH * 1024)
+
+/* Plaintext size for the in-memory archive round trip. */
+#define BENCH_ARCHIVE (16UL * 1024 * 1024)
+
+/* State shared by the benchmark bodies below. */
+struct bench {
+    uint8_t *in;
+    uint8_t *out;
+    uint8_t *plain;
+    size_t len;
+    size_t outlen;  /* archived length of plain */
+    int format;     /* archive format version */
+    int iexp;
+    chacha_ctx chacha[1];
+    uint8_t key[32];
+    uint8_t point[32];
+    uint8_t secret[32];
+    uint8_t public[32];
+    uint8_t epublic[32];
+    uint8_t iv[8];
+    uint8_t mac[SHA256_BLOCK_SIZE];
+};
+
+static void
+bench_chacha(struct bench *b)
+{
+    chacha_encrypt(b->chacha, b->in, b->out, b->len);
+}
+
+static void
+bench_sha256(struct bench *b)
+{
+    SHA256_CTX ctx[1];
+    sha256_init(ctx);
+    sha256_update(ctx, b->in, b->len);
+    sha256_final(ctx, b->mac);
+}
+
+static void
+bench_hmac(struct bench *b)
+{
+    SHA256_CTX ctx[1];
+    hmac_init(ctx, b->key);
+    sha256_update(ctx, b->in, b->len);
+    hmac_final(ctx, b->key, b->mac);
+}
+
+static void
+bench_poly1305(struct bench *b)
+{
+    poly1305_ctx ctx[1];
+    poly1305_init(ctx, b->key);
+    poly1305_update(ctx, b->in, b->len);
+    poly1305_finish(ctx, b->mac);
+}
+
+static void
+bench_curve25519(struct bench *b)
+{
+    curve25519_donna(b->point, b->secret, b->point);
+}
+
+static void
+bench_curve25519_base(struct bench *b)
+{
+    curve25519_donna_base(b->point, b->point);
+}
+
+static void
+bench_curve25519_table(struct bench *b)
+{
+    curve25519_donna_table(b->point, b->point, pubtable);
+}
+
+/* Points per curve25519_donna_batch() call */
+#define BENCH_BATCH 8
+
+static void
+bench_curve25519_batch(struct bench *b)
+{
+    uint8_t *out[BENCH_BATCH];
+    const uint8_t *secret[BENCH_BATCH];
+    const uint8_t *point[BENCH_BATCH];
+    int i;
+    for (i = 0; i < BENCH_BATCH; i++) {
+        out[i] = b->out + i * 32;
+        secret[i] = b->secret;
+        point[i] = b->out + i * 32;
+    }
+    curve25519_donna_batch(out, secret, point, BENCH_BATCH);
+}
+
+static void
+bench_kdf(struct bench *b)
+{
+    key_derive("", b->key, b->iexp, 0);
+}
+
+/* Everything command_archive() does besides I/O. */
+static void
+bench_archive(struct bench *b)
+{
+    uint8_t esecret[32];
+    uint8_t shared[32];
+    uint8_t iv[SHA256_BLOCK_SIZE];
+    SHA256_CTX ctx[1];
+    chacha_ctx chacha[1];
+
+    generate_secret(esecret);
+    compute_public(b->epublic, esecret);
+    compute_shared(shared, esecret, b->public);
+    sha256_init(ctx);
+    sha256_update(ctx, shared, sizeof(shared));
+    sha256_final(ctx, iv);
+    iv[0] += (unsigned)b->format;
+    memcpy(b->iv, iv, sizeof(b->iv));
+
+    cipher_init(chacha, shared, iv, b->format);
+    if (segment_tag(b->format)) {
+        int bad;
+        b->outlen = segment_crypt(shared, chacha, b->format, 0, 0, 1,
+                                  b->plain, b->out, b->len, &bad);
+    } else {
+        struct trailer trailer[1];
+        trailer_init(trailer, shared, b->format);
+        trailer_crypt(trailer, chacha, 0, b->plain, b->out, b->len);
+        trailer_final(trailer, b->mac);
+        b->outlen = b->len;
+    }
+}
+
+/* Everything command_extract() does besides I/O, checking the result. */
+static void
+bench_extract(struct bench *b)
+{
+    uint8_t shared[32];
+    uint8_t iv[SHA256_BLOCK_SIZE];
+    uint8_t mac[SHA256_BLOCK_SIZE];
+    SHA256_CTX ctx[1];
+    chacha_ctx chacha[1];
+
+    compute_shared(shared, b->secret, b->epublic);
+    sha256_init(ctx);
+    sha256_update(ctx, shared, sizeof(shared));
+    sha256_final(ctx, iv);
+    iv[0] += (unsigned)b->format;
+    if (memcmp(iv, b->iv, sizeof(b->iv)) != 0)
+        fatal("bench: round trip key mismatch");
+
+    cipher_init(chacha, shared, iv, b->format);
+    if (segment_tag(b->format)) {
+        int bad;
+        segment_crypt(shared, chacha, b->format, 0, 1, 1,
+                      b->out, b->in, b->outlen, &bad);
+        if (bad)
+            fatal("bench: round trip checksum mismatch");
+    } else {
+        struct trailer trailer[1];
+        trailer_init(trailer, shared, b->format);
+        trailer_crypt(trailer, chacha, 1, b->out, b->in, b->len);
+        trailer_final(trailer, mac);
+        if (memcmp(mac, b->mac, sizeof(mac)) != 0)
+            fatal("bench: round trip checksum mismatch");
+    }
+}
+
+/**
+ * Run FN repeatedly for at least BENCH_SECONDS of CPU time after one
+ * warm-up call, and store the mean seconds and cycles per call.
+ */
+static void
+bench_run(void (*fn)(struct bench *), struct bench *b,
+          double *seconds, double *cycles)
+{
+    unsigned long n = 0;
+    clock_t start, now;
+    double c0;
+
+    fn(b);
+    c0 = cpu_cycles();
+    start = clock();
+    do {
+        fn(b);
+        n++;
+        now = clock();
+    } while (now - start < BENCH_SECONDS * CLOCKS_PER_SEC);
+    *cycles = (cpu_cycles() - c0) / n;
+    *seconds = (now - start) / (double)CLOCKS_PER_SEC / n;
+}
+
+/**
+ * Print one benchmark result, where BYTES is the work per call, or
+ * zero when it's measured in operations. JSON results form the
+ * elements of an array, so all but the first get a leading comma.
+ */
+static void
+bench_report(int json, const char *name, const char *kernel,
+             size_t bytes, double seconds, double cycles)
+{
+    static int count;
+    if (json) {
+        printf("%s\n    {\"name\": \"%s\", \"kernel\": \"%s\", "
+               "\"bytes\": %lu, \"seconds\": %.9g, ",
+               count++ ? "," : "", name, kernel,
+               (unsigned long)bytes, seconds);
+        if (cycles)
+            printf("\"cycles\": %.0f, ", cycles);
+        else
+            printf("\"cycles\": null, ");
+        if (bytes) {
+            printf("\"mb_per_s\": %.1f, ", bytes / seconds / 1e6);
+            if (cycles)
+                printf("\"cycles_per_byte\": %.3f}", cycles / bytes);
+            else
+                printf("\"cycles_per_byte\": null}");
+        } else {
+            printf("\"ops_per_s\": %.3f}", 1 / seconds);
+        }
+    } else if (bytes) {
+        printf("%-16s %-12s %10.1f MB/s", name, kernel, bytes / seconds / 1e6);
+        if (cycles)
+            printf(" %10.2f cycles/byte", cycles / bytes);
+        putchar('\n');
+    } else {
+        printf("%-16s %-12s %10.1f ops/s %9.3f ms/op\n",
+               name, kernel, 1 / seconds, seconds * 1e3);
+    }
+}
+
+static void
+command_bench(struct optparse *options)
+{
+    static const struct optparse_long bench[] = {
+        {"json", 'J', OPTPARSE_NONE},
+        {0, 0, 0}
+    };
+    static const int kdf_exponents[] = {16, 20, 24};
+
+    int json = 0;
+    const char *chacha = chacha_kernels[chacha_kernel_current()].name;
+    const char *sha = sha256_kernels[sha256_kernel_current()].name;
+    const char *curve = curve25519_kernels[curve25519_kernel_current()].name;
+    static const int rounds[] = {8, 12, 20};
+    char both[64];
+    struct bench b[1];
+    double seconds, cycles;
+    char name[32];
+    size_t i;
+
+    int option;
+    while ((option = optparse_long(options, bench, 0)) != -1) {
+        switch (option) {
+            case 'J':
+                json = 1;
+                break;
+            default:
+                fatal("%s", options->errmsg);
+        }
+    }
+
+    memset(b, 0, sizeof(*b));
+    b->in = malloc(BENCH_ARCHIVE);
+    b->out = malloc(BENCH_ARCHIVE +
+                    (BENCH_ARCHIVE / SEGMENT_SIZE + 1) * SEGMENT_TAG_MAX);
+    b->plain = malloc(BENCH_ARCHIVE);
+    if (!b->in || !b->out || !b->plain)
+        fatal("not enough memory for benchmark");
+    for (i = 0; i < BENCH_ARCHIVE; i++)
+        b->plain[i] = b->in[i] = i * 2654435761UL >> 24;
+    chacha_keysetup(b->chacha, b->key, 256);
+    chacha_ivsetup(b->chacha, b->iv);
+    generate_secret(b->secret);
+    compute_public(b->public, b->secret);
+    b->point[0] = 9;
+    sprintf(both, "%s+%s", chacha, sha);
+
+    if (json)
+        printf("{\n  \"version\": \"%s\",\n  \"results\": [",
+               STR(ENCHIVE_VERSION));
+
+    b->len = BENCH_BUFLEN;
+    for (i = 0; i < sizeof(rounds) / sizeof(*rounds); i++) {
+        chacha_rounds(b->chacha, rounds[i]);
+        sprintf(name, "chacha%d", rounds[i]);
+        bench_run(bench_chacha, b, &seconds, &cycles);
+        bench_report(json, name, chacha, b->len, seconds, cycles);
+    }
+    chacha_rounds(b->chacha, CHACHA_ROUNDS);
+    bench_run(bench_sha256, b, &seconds, &cycles);
+    bench_report(json, "sha256", sha, b->len, seconds, cycles);
+    bench_run(bench_hmac, b, &seconds, &cycles);
+    bench_report(json, "hmac-sha256", sha, b->len, seconds, cycles);
+    bench_run(bench_poly1305, b, &seconds, &cycles);
+    bench_report(json, "poly1305", "portable", b->len, seconds, cycles);
+    bench_run(bench_curve25519, b, &seconds, &cycles);
+    bench_report(json, "curve25519", curve, 0, seconds, cycles);
+    for (i = 0; i < BENCH_BATCH; i++)
+        memcpy(b->out + i * 32, b->public, 32);
+    bench_run(bench_curve25519_batch, b, &seconds, &cycles);
+    bench_report(json, "curve25519-batch", curve, 0,
+                 seconds / BENCH_BATCH, cycles / BENCH_BATCH);
+    bench_run(bench_curve25519_base, b, &seconds, &cycles);
+    bench_report(json, "curve25519-base", curve, 0, seconds, cycles);
+    if (!curve25519_table(pubtable, b->public)) {
+        bench_run(bench_curve25519_table, b, &seconds, &cycles);
+        bench_report(json, "curve25519-table", curve, 0, seconds, cycles);
+    }
+
+    for (i = 0; i < sizeof(kdf_exponents) / sizeof(*kdf_exponents); i++) {
+        b->iexp = kdf_exponents[i];
+        sprintf(name, "key_derive-%d", b->iexp);
+        bench_run(bench_kdf, b, &seconds, &cycles);
+        bench_report(json, name, sha, 0, seconds, cycles);
+    }
+
+    /* The default format first, then the others by version. */
+    b->len = BENCH_ARCHIVE;
+    for (i = 2; i <= 8; i++) {
+        const char *kernel = both;
+        char suffix[8] = "";
+        b->format = i == 2 ? ENCHIVE_ARCHIVE_FORMAT : (int)i;
+        if (i > 2) {
+            if (b->format == ENCHIVE_ARCHIVE_FORMAT)
+                continue;
+            sprintf(suffix, "-v%d", b->format);
+        }
+        if (b->format == 5)
+            kernel = chacha;
+        bench_run(bench_archive, b, &seconds, &cycles);
+        sprintf(name, "archive%s", suffix);
+        bench_report(json, name, kernel, b->len, seconds, cycles);
+        bench_run(bench_extract, b, &seconds, &cycles);
+        sprintf(name, "extract%s", suffix);
+        bench_report(json, name, kernel, b->len, seconds, cycles);
+        if (memcmp(b->in, b->plain, b->len) != 0)
+            fatal("bench: round trip plaintext mismatch");
+    }
+
+    if (json)
+        printf("\n  ]\n}\n");
+
+    free(b->in);
+    free(b->out);
+    free(b->plain);
+}
+
 /**
  * Write a NULL-terminated array of strings with a newline after each.
  */
@@ -1655,8 +4828,10 @@ main(int argc, char **argv)
         {"no-agent",      'A', OPTPARSE_NONE},
 #endif
         {"pinentry",      'e', OPTPARSE_OPTIONAL},
+        {"kernel",        'K', OPTPARSE_REQUIRED},
         {"pubkey",        'p', OPTPARSE_REQUIRED},
         {"seckey",        's', OPTPARSE_REQUIRED},
+        {"verbose",       'v', OPTPARSE_NONE},
         {"version",       'V', OPTPARSE_NONE},
         {"help",          'h', OPTPARSE_NONE},
         {0, 0, 0}
@@ -1664,6 +4839,9 @@ main(int argc, char **argv)
 
     int option;
     char *command;
+    char *kernel = 0;
+    int list_kernels = 0;
+    const char *err;
     struct optparse options[1];
     optparse_init(options, argv);
     options->permute = 0;
@@ -1693,12 +4871,18 @@ main(int argc, char **argv)
                 else
                     pinentry_path = STR(ENCHIVE_PINENTRY_DEFAULT);
                 break;
+            case 'K':
+                kernel = options->optarg;
+                break;
             case 'p':
                 global_pubkey = options->optarg;
                 break;
             case 's':
                 global_seckey = options->optarg;
                 break;
+            case 'v':
+                global_verbose = 1;
+                break;
             case 'h':
                 print_usage(stdout);
                 exit(EXIT_SUCCESS);
@@ -1712,6 +4896,23 @@ main(int argc, char **argv)
         }
     }
 
+    /* Select crypto kernels before doing any work. */
+    if (!kernel)
+        kernel = getenv("ENCHIVE_KERNEL");
+    if (kernel && !strcmp(kernel, "list")) {
+        /* List the kernels $ENCHIVE_KERNEL would select. */
+        list_kernels = 1;
+        kernel = getenv("ENCHIVE_KERNEL");
+        if (kernel && !strcmp(kernel, "list"))
+            kernel = 0;
+    }
+    if ((err = cpu_select(kernel)))
+        fatal("%s -- %s", err, kernel);
+    if (list_kernels) {
+        cpu_print(stdout);
+        exit(EXIT_SUCCESS);
+    }
+
     command = optparse_arg(options);
     options->permute = 1;
     if (!command) {
@@ -1745,6 +4946,12 @@ main(int argc, char **argv)
         case COMMAND_EXTRACT:
             command_extract(options);
             break;
+        case COMMAND_TABLE:
+            command_table(options);
+            break;
+        case COMMAND_BENCH:
+            command_bench(options);
+            break;
     }
 
     cleanup_free();
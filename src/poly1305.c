@@ -0,0 +1,235 @@
+/*
+poly1305-donna-64, after Andrew Moon's poly1305-donna
+Public domain.
+
+Three 44/44/42-bit limbs, so each block costs nine 64x64->128-bit
+multiplies. Compilers without a 128-bit type get the products from
+32-bit halves instead.
+*/
+
+#include "poly1305.h"
+
+#define U8TO64_LITTLE(p) \
+  (((uint64_t)((p)[0])      ) | \
+   ((uint64_t)((p)[1]) <<  8) | \
+   ((uint64_t)((p)[2]) << 16) | \
+   ((uint64_t)((p)[3]) << 24) | \
+   ((uint64_t)((p)[4]) << 32) | \
+   ((uint64_t)((p)[5]) << 40) | \
+   ((uint64_t)((p)[6]) << 48) | \
+   ((uint64_t)((p)[7]) << 56))
+
+#define U64TO8_LITTLE(p, v) \
+  do { \
+    int i_; \
+    for (i_ = 0; i_ < 8; i_++) \
+      (p)[i_] = (uint8_t)((v) >> (8 * i_)); \
+  } while (0)
+
+#define MASK44 UINT64_C(0xfffffffffff)
+#define MASK42 UINT64_C(0x3ffffffffff)
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 u128;
+#define MUL(out, x, y) out = (u128)(x) * (y)
+#define ADD(out, in) out += in
+#define ADDLO(out, in) out += in
+#define SHR(in, shift) ((uint64_t)((in) >> (shift)))
+#define LO(in) ((uint64_t)(in))
+#else
+typedef struct {
+  uint64_t lo;
+  uint64_t hi;
+} u128;
+
+static u128
+mul64(uint64_t x, uint64_t y)
+{
+  uint64_t x0 = x & 0xffffffff, x1 = x >> 32;
+  uint64_t y0 = y & 0xffffffff, y1 = y >> 32;
+  uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+  uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+  u128 r;
+  r.lo = (mid << 32) | (p00 & 0xffffffff);
+  r.hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+  return r;
+}
+
+#define MUL(out, x, y) out = mul64((x), (y))
+#define ADD(out, in) \
+  do { \
+    uint64_t t_ = (out).lo; \
+    (out).lo += (in).lo; \
+    (out).hi += (in).hi + ((out).lo < t_); \
+  } while (0)
+#define ADDLO(out, in) \
+  do { \
+    uint64_t t_ = (out).lo; \
+    (out).lo += (in); \
+    (out).hi += ((out).lo < t_); \
+  } while (0)
+#define SHR(in, shift) (((in).hi << (64 - (shift))) | ((in).lo >> (shift)))
+#define LO(in) ((in).lo)
+#endif
+
+void
+poly1305_init(poly1305_ctx *x, const uint8_t *key)
+{
+  uint64_t t0 = U8TO64_LITTLE(key + 0);
+  uint64_t t1 = U8TO64_LITTLE(key + 8);
+
+  /* r &= 0xffffffc0ffffffc0ffffffc0fffffff */
+  x->r[0] = t0 & UINT64_C(0xffc0fffffff);
+  x->r[1] = ((t0 >> 44) | (t1 << 20)) & UINT64_C(0xfffffc0ffff);
+  x->r[2] = (t1 >> 24) & UINT64_C(0x00ffffffc0f);
+
+  x->h[0] = 0;
+  x->h[1] = 0;
+  x->h[2] = 0;
+
+  x->pad[0] = U8TO64_LITTLE(key + 16);
+  x->pad[1] = U8TO64_LITTLE(key + 24);
+
+  x->leftover = 0;
+  x->final = 0;
+}
+
+static void
+poly1305_blocks(poly1305_ctx *x, const uint8_t *m, size_t bytes)
+{
+  const uint64_t hibit = x->final ? 0 : UINT64_C(1) << 40; /* 1 << 128 */
+  uint64_t r0 = x->r[0], r1 = x->r[1], r2 = x->r[2];
+  uint64_t s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+  uint64_t h0 = x->h[0], h1 = x->h[1], h2 = x->h[2];
+  uint64_t c, t0, t1;
+  u128 d0, d1, d2, d;
+
+  while (bytes >= 16) {
+    /* h += m[i] */
+    t0 = U8TO64_LITTLE(m + 0);
+    t1 = U8TO64_LITTLE(m + 8);
+    h0 += t0 & MASK44;
+    h1 += ((t0 >> 44) | (t1 << 20)) & MASK44;
+    h2 += ((t1 >> 24) & MASK42) | hibit;
+
+    /* h *= r */
+    MUL(d0, h0, r0); MUL(d, h1, s2); ADD(d0, d); MUL(d, h2, s1); ADD(d0, d);
+    MUL(d1, h0, r1); MUL(d, h1, r0); ADD(d1, d); MUL(d, h2, s2); ADD(d1, d);
+    MUL(d2, h0, r2); MUL(d, h1, r1); ADD(d2, d); MUL(d, h2, r0); ADD(d2, d);
+
+    /* (partial) h %= p */
+    c = SHR(d0, 44); h0 = LO(d0) & MASK44;
+    ADDLO(d1, c); c = SHR(d1, 44); h1 = LO(d1) & MASK44;
+    ADDLO(d2, c); c = SHR(d2, 42); h2 = LO(d2) & MASK42;
+    h0 += c * 5; c = h0 >> 44; h0 &= MASK44;
+    h1 += c;
+
+    m += 16;
+    bytes -= 16;
+  }
+
+  x->h[0] = h0;
+  x->h[1] = h1;
+  x->h[2] = h2;
+}
+
+void
+poly1305_update(poly1305_ctx *x, const uint8_t *m, size_t bytes)
+{
+  size_t i;
+
+  /* handle leftover */
+  if (x->leftover) {
+    size_t want = 16 - x->leftover;
+    if (want > bytes)
+      want = bytes;
+    for (i = 0; i < want; i++)
+      x->buffer[x->leftover + i] = m[i];
+    bytes -= want;
+    m += want;
+    x->leftover += want;
+    if (x->leftover < 16)
+      return;
+    poly1305_blocks(x, x->buffer, 16);
+    x->leftover = 0;
+  }
+
+  /* process full blocks */
+  if (bytes >= 16) {
+    size_t want = bytes & ~(size_t)15;
+    poly1305_blocks(x, m, want);
+    m += want;
+    bytes -= want;
+  }
+
+  /* store leftover */
+  for (i = 0; i < bytes; i++)
+    x->buffer[x->leftover + i] = m[i];
+  x->leftover += bytes;
+}
+
+void
+poly1305_finish(poly1305_ctx *x, uint8_t *mac)
+{
+  uint64_t h0, h1, h2, c;
+  uint64_t g0, g1, g2;
+  uint64_t t0, t1;
+
+  /* process the remaining block */
+  if (x->leftover) {
+    size_t i = x->leftover;
+    x->buffer[i++] = 1;
+    for (; i < 16; i++)
+      x->buffer[i] = 0;
+    x->final = 1;
+    poly1305_blocks(x, x->buffer, 16);
+  }
+
+  /* fully carry h */
+  h0 = x->h[0];
+  h1 = x->h[1];
+  h2 = x->h[2];
+
+  c = (h1 >> 44); h1 &= MASK44;
+  h2 += c; c = (h2 >> 42); h2 &= MASK42;
+  h0 += c * 5; c = (h0 >> 44); h0 &= MASK44;
+  h1 += c; c = (h1 >> 44); h1 &= MASK44;
+  h2 += c; c = (h2 >> 42); h2 &= MASK42;
+  h0 += c * 5; c = (h0 >> 44); h0 &= MASK44;
+  h1 += c;
+
+  /* compute h + -p */
+  g0 = h0 + 5; c = (g0 >> 44); g0 &= MASK44;
+  g1 = h1 + c; c = (g1 >> 44); g1 &= MASK44;
+  g2 = h2 + c - (UINT64_C(1) << 42);
+
+  /* select h if h < p, or h + -p if h >= p */
+  c = (g2 >> 63) - 1;
+  g0 &= c;
+  g1 &= c;
+  g2 &= c;
+  c = ~c;
+  h0 = (h0 & c) | g0;
+  h1 = (h1 & c) | g1;
+  h2 = (h2 & c) | g2;
+
+  /* h = (h + pad) */
+  t0 = x->pad[0];
+  t1 = x->pad[1];
+
+  h0 += t0 & MASK44; c = (h0 >> 44); h0 &= MASK44;
+  h1 += (((t0 >> 44) | (t1 << 20)) & MASK44) + c; c = (h1 >> 44); h1 &= MASK44;
+  h2 += ((t1 >> 24) & MASK42) + c; h2 &= MASK42;
+
+  /* mac = h % (2^128) */
+  h0 = (h0 | (h1 << 44));
+  h1 = ((h1 >> 20) | (h2 << 24));
+
+  U64TO8_LITTLE(mac + 0, h0);
+  U64TO8_LITTLE(mac + 8, h1);
+
+  /* zero out the state */
+  x->h[0] = x->h[1] = x->h[2] = 0;
+  x->r[0] = x->r[1] = x->r[2] = 0;
+  x->pad[0] = x->pad[1] = 0;
+}
@@ -0,0 +1,24 @@
+#ifndef POLY1305_H
+#define POLY1305_H
+
+#include <stddef.h>
+#include "../config.h"
+
+#define POLY1305_KEYLENGTH 32
+#define POLY1305_TAGLENGTH 16
+
+typedef struct {
+    uint64_t r[3];
+    uint64_t h[3];
+    uint64_t pad[2];
+    size_t leftover;
+    uint8_t buffer[16];
+    uint8_t final;
+} poly1305_ctx;
+
+/* The key must never be used for more than one message. */
+void poly1305_init(poly1305_ctx *, const uint8_t *key);
+void poly1305_update(poly1305_ctx *, const uint8_t *m, size_t bytes);
+void poly1305_finish(poly1305_ctx *, uint8_t *mac);
+
+#endif /* POLY1305_H */
@@ -28,6 +28,12 @@
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+#if defined(__GNUC__)
+#define SHA256_INLINE __inline__ __attribute__((always_inline))
+#else
+#define SHA256_INLINE
+#endif
+
 /**************************** VARIABLES *****************************/
 static const uint32_t k[64] = {
 	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -41,45 +47,232 @@ static const uint32_t k[64] = {
 };
 
 /*********************** FUNCTION DEFINITIONS ***********************/
-void sha256_transform(SHA256_CTX *ctx, const uint8_t data[])
+#define ROUND(a,b,c,d,e,f,g,h,i) \
+	t1 = h + EP1(e) + CH(e,f,g) + wk[(i) * stride]; \
+	d += t1; \
+	h = t1 + EP0(a) + MAJ(a,b,c);
+
+/* The 64 rounds over a message schedule with the round constants
+ * already added in, wk[i * stride] holding W[i] + K[i]. */
+static SHA256_INLINE void sha256_rounds(uint32_t state[8], const uint32_t *wk, size_t stride)
 {
-	uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+	uint32_t a, b, c, d, e, f, g, h, i, t1;
+
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
+
+	/* Eight rounds per iteration, rotating the variable names
+	 * instead of shuffling the values. */
+	for (i = 0; i < 64; i += 8) {
+		ROUND(a,b,c,d,e,f,g,h,i + 0)
+		ROUND(h,a,b,c,d,e,f,g,i + 1)
+		ROUND(g,h,a,b,c,d,e,f,i + 2)
+		ROUND(f,g,h,a,b,c,d,e,i + 3)
+		ROUND(e,f,g,h,a,b,c,d,i + 4)
+		ROUND(d,e,f,g,h,a,b,c,i + 5)
+		ROUND(c,d,e,f,g,h,a,b,i + 6)
+		ROUND(b,c,d,e,f,g,h,a,i + 7)
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+#define LOAD32_BE(p) \
+	(((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+	 ((uint32_t)(p)[2] << 8) | ((uint32_t)(p)[3]))
 
-	for (i = 0, j = 0; i < 16; ++i, j += 4)
-		m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+static SHA256_INLINE void sha256_compress(uint32_t state[8], const uint8_t data[])
+{
+	uint32_t i, m[64];
+
+	for (i = 0; i < 16; ++i)
+		m[i] = LOAD32_BE(data + 4 * i);
 	for ( ; i < 64; ++i)
 		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+	for (i = 0; i < 64; ++i)
+		m[i] += k[i];
+
+	sha256_rounds(state, m, 1);
+}
+
+/* Portable kernel: compress n consecutive 64-byte blocks. */
+static void sha256_blocks_ref(uint32_t state[8], const uint8_t data[], size_t n)
+{
+	for (; n; n--, data += 64)
+		sha256_compress(state, data);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_X86 1
+
+typedef uint32_t sha256_v8 __attribute__((vector_size(32)));
+
+#define VROTR(x,n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define VSIG0(x) (VROTR(x,7) ^ VROTR(x,18) ^ ((x) >> 3))
+#define VSIG1(x) (VROTR(x,17) ^ VROTR(x,19) ^ ((x) >> 10))
+
+/* AVX2/BMI2 kernel. The message schedules of eight consecutive blocks
+ * are computed together, one block per vector lane, then the rounds
+ * run block by block on the transposed schedule. The rounds are the
+ * portable code compiled so that the rotates become BMI2 rorx. */
+__attribute__((target("avx2,bmi2")))
+static void sha256_blocks_avx2(uint32_t state[8], const uint8_t data[], size_t n)
+{
+	sha256_v8 w[64];
+	size_t i, j;
+
+	for (; n >= 8; n -= 8, data += 8 * 64) {
+		for (i = 0; i < 16; ++i)
+			for (j = 0; j < 8; ++j)
+				w[i][j] = LOAD32_BE(data + 64 * j + 4 * i);
+		for ( ; i < 64; ++i)
+			w[i] = VSIG1(w[i - 2]) + w[i - 7] + VSIG0(w[i - 15]) + w[i - 16];
+		for (i = 0; i < 64; ++i)
+			w[i] += k[i];
+		for (j = 0; j < 8; ++j)
+			sha256_rounds(state, (uint32_t *)w + j, 8);
+	}
+	for (; n; n--, data += 64)
+		sha256_compress(state, data);
+}
+
+/* SHA extensions (SHA-NI) kernel, written against the compiler
+ * builtins and vector extensions so no intrinsics headers are needed.
+ * The state is kept as the {F,E,B,A} and {H,G,D,C} vectors expected
+ * by sha256rnds2. */
+typedef int sha256_v4i __attribute__((vector_size(16)));
+typedef uint32_t sha256_v4 __attribute__((vector_size(16)));
+
+#ifdef __clang__
+#  define SHUFFLE4(a, b, i, j, k, l) \
+	__builtin_shufflevector(a, b, i, j, k, l)
+#else
+#  define SHUFFLE4(a, b, i, j, k, l) \
+	__builtin_shuffle(a, b, __extension__ (sha256_v4){i, j, k, l})
+#endif
+
+#define RNDS2(a, b, w) ((sha256_v4)__builtin_ia32_sha256rnds2( \
+	(sha256_v4i)(a), (sha256_v4i)(b), (sha256_v4i)(w)))
+#define MSG1(a, b) ((sha256_v4)__builtin_ia32_sha256msg1( \
+	(sha256_v4i)(a), (sha256_v4i)(b)))
+#define MSG2(a, b) ((sha256_v4)__builtin_ia32_sha256msg2( \
+	(sha256_v4i)(a), (sha256_v4i)(b)))
+#define BSWAP4(x) (((x) << 24) | (((x) << 8) & 0xff0000) | \
+	(((x) >> 8) & 0xff00) | ((x) >> 24))
+
+/* Four rounds using message words w. */
+#define QROUND(i, w) \
+	memcpy(&t, k + 4 * (i), 16); \
+	t += w; \
+	st1 = RNDS2(st1, st0, t); \
+	t = SHUFFLE4(t, t, 2, 3, 0, 1); \
+	st0 = RNDS2(st0, st1, t);
+
+/* Extend the schedule: w0 becomes the words following w3. */
+#define SCHEDULE(w0, w1, w2, w3) \
+	w0 = MSG2(MSG1(w0, w1) + SHUFFLE4(w2, w3, 1, 2, 3, 4), w3);
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_blocks_shani(uint32_t state[8], const uint8_t data[], size_t n)
+{
+	sha256_v4 st0, st1, save0, save1, w0, w1, w2, w3, t;
+	int i;
 
-	a = ctx->state[0];
-	b = ctx->state[1];
-	c = ctx->state[2];
-	d = ctx->state[3];
-	e = ctx->state[4];
-	f = ctx->state[5];
-	g = ctx->state[6];
-	h = ctx->state[7];
-
-	for (i = 0; i < 64; ++i) {
-		t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-		t2 = EP0(a) + MAJ(a,b,c);
-		h = g;
-		g = f;
-		f = e;
-		e = d + t1;
-		d = c;
-		c = b;
-		b = a;
-		a = t1 + t2;
+	st0[0] = state[5]; st0[1] = state[4]; st0[2] = state[1]; st0[3] = state[0];
+	st1[0] = state[7]; st1[1] = state[6]; st1[2] = state[3]; st1[3] = state[2];
+
+	for (; n; n--, data += 64) {
+		save0 = st0;
+		save1 = st1;
+
+		memcpy(&w0, data +  0, 16);
+		memcpy(&w1, data + 16, 16);
+		memcpy(&w2, data + 32, 16);
+		memcpy(&w3, data + 48, 16);
+		w0 = BSWAP4(w0);
+		w1 = BSWAP4(w1);
+		w2 = BSWAP4(w2);
+		w3 = BSWAP4(w3);
+		QROUND(0, w0)
+		QROUND(1, w1)
+		QROUND(2, w2)
+		QROUND(3, w3)
+
+		for (i = 4; i < 16; i += 4) {
+			SCHEDULE(w0, w1, w2, w3)
+			QROUND(i + 0, w0)
+			SCHEDULE(w1, w2, w3, w0)
+			QROUND(i + 1, w1)
+			SCHEDULE(w2, w3, w0, w1)
+			QROUND(i + 2, w2)
+			SCHEDULE(w3, w0, w1, w2)
+			QROUND(i + 3, w3)
+		}
+
+		st0 += save0;
+		st1 += save1;
 	}
 
-	ctx->state[0] += a;
-	ctx->state[1] += b;
-	ctx->state[2] += c;
-	ctx->state[3] += d;
-	ctx->state[4] += e;
-	ctx->state[5] += f;
-	ctx->state[6] += g;
-	ctx->state[7] += h;
+	state[0] = st0[3]; state[1] = st0[2]; state[4] = st0[1]; state[5] = st0[0];
+	state[2] = st1[3]; state[3] = st1[2]; state[6] = st1[1]; state[7] = st1[0];
+}
+#endif /* SHA256_X86 */
+
+typedef void (*sha256_fn)(uint32_t [8], const uint8_t [], size_t);
+
+/* Best first, matching sha256_kernels. */
+static const sha256_fn sha256_impls[] = {
+#ifdef SHA256_X86
+	sha256_blocks_shani,
+	sha256_blocks_avx2,
+#endif
+	sha256_blocks_ref
+};
+
+const struct cpu_kernel sha256_kernels[] = {
+#ifdef SHA256_X86
+	{"sha", CPU_SHA | CPU_SSE41},
+	{"avx2", CPU_AVX2 | CPU_BMI2},
+#endif
+	{"portable", 0},
+	{0, 0}
+};
+
+static int sha256_current = -1;
+static sha256_fn sha256_blocks;
+
+void sha256_kernel_use(int kernel)
+{
+	sha256_current = kernel;
+	sha256_blocks = sha256_impls[kernel];
+}
+
+int sha256_kernel_current(void)
+{
+	if (sha256_current < 0)
+		sha256_kernel_use(cpu_best(sha256_kernels));
+	return sha256_current;
+}
+
+/* Compress n blocks with the selected kernel. */
+static void sha256_transform(uint32_t state[8], const uint8_t data[], size_t n)
+{
+	if (!sha256_blocks)
+		sha256_kernel_current();
+	sha256_blocks(state, data, n);
 }
 
 void sha256_init(SHA256_CTX *ctx)
@@ -98,16 +291,54 @@ void sha256_init(SHA256_CTX *ctx)
 
 void sha256_update(SHA256_CTX *ctx, const uint8_t data[], size_t len)
 {
+	size_t i = 0;
+
+	/* Top off a partially filled buffer. */
+	if (ctx->datalen) {
+		for (; i < len && ctx->datalen < 64; ++i)
+			ctx->data[ctx->datalen++] = data[i];
+		if (ctx->datalen < 64)
+			return;
+		sha256_transform(ctx->state, ctx->data, 1);
+		ctx->bitlen += 512;
+		ctx->datalen = 0;
+	}
+
+	/* Compress whole blocks straight from the input. */
+	if (len - i >= 64) {
+		size_t n = (len - i) / 64;
+		sha256_transform(ctx->state, data + i, n);
+		ctx->bitlen += (uint64_t)n * 512;
+		i += n * 64;
+	}
+
+	for (; i < len; ++i)
+		ctx->data[ctx->datalen++] = data[i];
+}
+
+void sha256_hash32(uint8_t hash[], const uint8_t data[])
+{
+	/* Padding for a 32-byte message: 0x80, zeros, 256-bit length. */
+	static const uint8_t pad[32] = {
+		0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+	};
+	uint32_t state[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+		0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	uint8_t block[64];
 	uint32_t i;
 
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
-		if (ctx->datalen == 64) {
-			sha256_transform(ctx, ctx->data);
-			ctx->bitlen += 512;
-			ctx->datalen = 0;
-		}
+	memcpy(block, data, 32);
+	memcpy(block + 32, pad, 32);
+	sha256_transform(state, block, 1);
+
+	for (i = 0; i < 8; ++i) {
+		hash[i * 4 + 0] = state[i] >> 24;
+		hash[i * 4 + 1] = state[i] >> 16;
+		hash[i * 4 + 2] = state[i] >> 8;
+		hash[i * 4 + 3] = state[i];
 	}
 }
 
@@ -127,7 +358,7 @@ void sha256_final(SHA256_CTX *ctx, uint8_t hash[])
 		ctx->data[i++] = 0x80;
 		while (i < 64)
 			ctx->data[i++] = 0x00;
-		sha256_transform(ctx, ctx->data);
+		sha256_transform(ctx->state, ctx->data, 1);
 		memset(ctx->data, 0, 56);
 	}
 
@@ -141,7 +372,7 @@ void sha256_final(SHA256_CTX *ctx, uint8_t hash[])
 	ctx->data[58] = ctx->bitlen >> 40;
 	ctx->data[57] = ctx->bitlen >> 48;
 	ctx->data[56] = ctx->bitlen >> 56;
-	sha256_transform(ctx, ctx->data);
+	sha256_transform(ctx->state, ctx->data, 1);
 
 	/* Since this implementation uses little endian byte ordering and SHA uses big endian, */
 	/* reverse all the bytes when copying the final state to the output hash. */
@@ -11,6 +11,7 @@
 
 #include <stddef.h>
 #include "../config.h"
+#include "cpu.h"
 
 #define SHA256_BLOCK_SIZE 32
 
@@ -25,5 +26,13 @@ void sha256_init(SHA256_CTX *ctx);
 void sha256_update(SHA256_CTX *ctx, const uint8_t data[], size_t len);
 void sha256_final(SHA256_CTX *ctx, uint8_t hash[]);
 
+/* One-shot SHA-256 of exactly 32 bytes. The hash may overwrite data. */
+void sha256_hash32(uint8_t hash[], const uint8_t data[]);
+
+/* Runtime kernel selection, see cpu.h. */
+extern const struct cpu_kernel sha256_kernels[];
+void sha256_kernel_use(int kernel);
+int sha256_kernel_current(void);
+
 #endif /* SHA256_H */
 